@@ -0,0 +1,39 @@
+# Writes the build time in UTC as the register image of the PCF85063A time block:
+# sec, min, hr, day(1-31), weekday, month, year, all BCD. The chip keeps UTC, local
+# time is derived from it (CONFIG_PCF85063A_TZ).
+#
+# Usage: cmake -DOUTPUT=<header> -P pcf85063a_build_time.cmake
+
+if(NOT OUTPUT)
+  message(FATAL_ERROR "OUTPUT must name the header to generate")
+endif()
+
+# One timestamp call so the fields can't straddle a second boundary
+string(TIMESTAMP stamp "%S;%M;%H;%d;%w;%m;%Y" UTC)
+list(GET stamp 0 seconds)
+list(GET stamp 1 minutes)
+list(GET stamp 2 hours)
+list(GET stamp 3 day)
+list(GET stamp 4 weekday)
+list(GET stamp 5 month)
+list(GET stamp 6 year)
+
+# The chip only stores two year digits and counts 2000-2099
+string(SUBSTRING ${year} 0 2 century)
+string(SUBSTRING ${year} 2 2 year)
+if(NOT century STREQUAL "20")
+  message(FATAL_ERROR "Build year ${century}${year} is outside the PCF85063A range 2000-2099")
+endif()
+
+# Two decimal digits read as hex are already their BCD encoding
+file(WRITE ${OUTPUT}.tmp
+"/* Generated by cmake/pcf85063a_build_time.cmake, do not edit */
+#ifndef PCF85063A_BUILD_TIME_H
+#define PCF85063A_BUILD_TIME_H
+
+#define PCF85063A_BUILD_CENTURY ${century}
+#define PCF85063A_BUILD_TIME_BCD {0x${seconds}, 0x${minutes}, 0x${hours}, 0x${day}, 0x0${weekday}, 0x${month}, 0x${year}}
+
+#endif
+")
+file(RENAME ${OUTPUT}.tmp ${OUTPUT})
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Reports the ROM and RAM taken by the PCF85063A driver sources.
+
+Symbols are read from the object files of the driver with nm. Code, read-only
+data and initialised data count as ROM, initialised data and zero-initialised
+data as RAM. When the linked ELF is given, symbols it dropped through section
+garbage collection are left out and sizes are taken from it.
+
+Usage: pcf85063a_footprint.py --nm nm [--config .config] [--elf zephyr.elf] objects...
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+# nm symbol types, upper and lower case
+ROM_TYPES = "tr"
+DATA_TYPES = "dg"
+RAM_TYPES = "bcs"
+
+
+def symbols(nm, path):
+    """List of (name, type, size) of the symbols defined in path."""
+    try:
+        output = subprocess.run([nm, "--print-size", "--defined-only", path],
+                                check=True, capture_output=True, text=True).stdout
+    except (OSError, subprocess.CalledProcessError) as error:
+        sys.exit(f"{nm} failed on {path}: {error}")
+
+    result = []
+    for line in output.splitlines():
+        fields = line.split()
+        # Symbols without a size (labels, section markers) take no space of their own
+        if len(fields) == 4:
+            result.append((fields[3], fields[2].lower(), int(fields[1], 16)))
+    return result
+
+
+def footprint(nm, path, linked):
+    """(rom, ram) of one object file, limited to symbols kept in linked if given."""
+    rom = ram = 0
+    for name, kind, size in symbols(nm, path):
+        if linked is not None:
+            if name not in linked:
+                continue
+            size = linked[name]
+        if kind in ROM_TYPES:
+            rom += size
+        elif kind in DATA_TYPES:
+            rom += size
+            ram += size
+        elif kind in RAM_TYPES:
+            ram += size
+    return rom, ram
+
+
+def enabled_options(path):
+    """CONFIG_PCF85063A_* lines of a Kconfig .config, unset options included."""
+    if path is None or not os.path.exists(path):
+        return []
+    with open(path) as config:
+        return [line.strip() for line in config if "CONFIG_PCF85063A_" in line]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--nm", default="nm", help="nm of the toolchain")
+    parser.add_argument("--config", help="Kconfig .config of the build")
+    parser.add_argument("--elf", help="linked image, optional")
+    parser.add_argument("objects", nargs="+", help="object files of the application")
+    args = parser.parse_args()
+
+    # Driver sources are src/PCF85063A*.c, tests and the application are not counted
+    objects = sorted(path for path in args.objects
+                     if os.path.basename(path).startswith("PCF85063A"))
+    if not objects:
+        sys.exit("No PCF85063A object files given")
+
+    linked = None
+    if args.elf is not None and os.path.exists(args.elf):
+        linked = {}
+        for name, _, size in symbols(args.nm, args.elf):
+            linked[name] = size
+
+    rows = [(os.path.basename(path), *footprint(args.nm, path, linked)) for path in objects]
+    width = max(len("Total"), *(len(name) for name, _, _ in rows))
+
+    print(f"{'File':<{width}}  {'ROM':>8}  {'RAM':>8}")
+    for name, rom, ram in rows:
+        print(f"{name:<{width}}  {rom:>8}  {ram:>8}")
+    print(f"{'Total':<{width}}  {sum(row[1] for row in rows):>8}  "
+          f"{sum(row[2] for row in rows):>8}")
+    print("Sizes from " + ("the linked image" if linked is not None else "the object files"))
+
+    options = enabled_options(args.config)
+    if options:
+        print()
+        print("\n".join(options))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""Writes the UTC offset transitions of one time zone as a C header.
+
+The table covers the PCF85063A range 2000-2099. Each entry is the UTC second an
+offset starts at and the offset in minutes; the first entry starts at 0 and
+covers all earlier times. Offsets come from the build host's time zone database
+through zoneinfo, rules for future years included.
+
+Usage: pcf85063a_tz_table.py --zone Europe/Berlin --output pcf85063a_tz_table.h
+"""
+
+import argparse
+import os
+import sys
+from datetime import datetime, timezone
+from zoneinfo import ZoneInfo, ZoneInfoNotFoundError
+
+RANGE_START = 946684800  # 2000-01-01 00:00:00 UTC
+RANGE_END = 4102444800  # 2100-01-01 00:00:00 UTC
+# Zones do not change their offset twice within this step
+SCAN_STEP = 6 * 3600
+
+
+def utc_offset(zone, seconds):
+    """UTC offset of zone in seconds at a UTC time."""
+    local = datetime.fromtimestamp(seconds, tz=timezone.utc).astimezone(zone)
+    return int(local.utcoffset().total_seconds())
+
+
+def first_second_with(zone, low, high, offset):
+    """First second in (low, high] at which zone has offset, which it has at high."""
+    while high - low > 1:
+        middle = (low + high) // 2
+        if utc_offset(zone, middle) == offset:
+            high = middle
+        else:
+            low = middle
+    return high
+
+
+def transitions(zone):
+    """List of (start, offset seconds) pairs, the first starting at 0."""
+    previous = utc_offset(zone, RANGE_START)
+    table = [(0, previous)]
+
+    for seconds in range(RANGE_START + SCAN_STEP, RANGE_END + SCAN_STEP, SCAN_STEP):
+        offset = utc_offset(zone, seconds)
+        if offset != previous:
+            table.append((first_second_with(zone, seconds - SCAN_STEP, seconds, offset), offset))
+            previous = offset
+
+    return table
+
+
+def write_header(path, name, table):
+    for _, offset in table:
+        if offset % 60 != 0:
+            sys.exit(f"{name}: offset {offset} s is not a whole number of minutes")
+
+    starts = ",\n".join(f"\t{start}" for start, _ in table)
+    offsets = ",\n".join(f"\t{offset // 60}" for _, offset in table)
+    text = f"""/* Generated by cmake/pcf85063a_tz_table.py for {name}, do not edit */
+#ifndef PCF85063A_TZ_TABLE_H
+#define PCF85063A_TZ_TABLE_H
+
+#include <stdint.h>
+
+#define PCF85063A_TZ_NAME "{name}"
+#define PCF85063A_TZ_TRANSITIONS {len(table)}
+
+// UTC seconds since the Unix epoch each offset starts at
+static const uint32_t pcf85063a_tz_starts[PCF85063A_TZ_TRANSITIONS] = {{
+{starts}
+}};
+
+// UTC offsets in minutes
+static const int16_t pcf85063a_tz_offsets[PCF85063A_TZ_TRANSITIONS] = {{
+{offsets}
+}};
+
+#endif
+"""
+    os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+    with open(path + ".tmp", "w") as header:
+        header.write(text)
+    os.replace(path + ".tmp", path)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--zone", required=True, help="IANA time zone name, e.g. Europe/Berlin")
+    parser.add_argument("--output", required=True, help="header to write")
+    args = parser.parse_args()
+
+    try:
+        zone = ZoneInfo(args.zone)
+    except (ZoneInfoNotFoundError, ValueError):
+        sys.exit(f"Unknown time zone {args.zone}")
+
+    write_header(args.output, args.zone, transitions(zone))
+
+
+if __name__ == "__main__":
+    main()
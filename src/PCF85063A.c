@@ -1,265 +1,702 @@
 #include <zephyr/drivers/i2c.h>
 #include <string.h>
-#include <stdlib.h>
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/rtc.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/pm/device_runtime.h>
+#include <zephyr/sys/atomic.h>
 #include "PCF85063A.h"
+#include "PCF85063A_bus.h"
+#include "PCF85063A_stats.h"
+#if defined(CONFIG_PCF85063A_DEEP_SLEEP) && defined(CONFIG_RTC_ALARM)
+#include "PCF85063A_alarm_mux.h"
+#endif
+#ifdef CONFIG_PCF85063A_BUILD_TIME
+#include "pcf85063a_build_time.h"
+#endif
+
+#define DT_DRV_COMPAT nxp_pcf85063a
 
 LOG_MODULE_REGISTER(pcf85063a, CONFIG_PCF85063A_LOG_LEVEL);
-static const struct device *pcf_85063A;
-static const struct gpio_dt_spec int_gpio = GPIO_DT_SPEC_GET(PCF85063A_INT_NODE, gpios);
-static struct gpio_callback gpio_cb;
-static struct k_work alarm_work;
 volatile bool alarm_trigger = false;
 
+#define FAST_NOW_DRIFT_LIMIT_MS                                                                    \
+	((int64_t)RTC_FAST_NOW_MAX_DRIFT_MS * 1000000 / RTC_FAST_NOW_CLOCK_PPM)
+#define FAST_NOW_SYNC_INTERVAL_MS MIN(RTC_FAST_NOW_RESYNC_MS, FAST_NOW_DRIFT_LIMIT_MS)
+
+// Bursts of operations closer together than this share one resume of the device and its bus
+#ifdef CONFIG_PM_DEVICE_RUNTIME
+#define PM_IDLE_DELAY K_MSEC(CONFIG_PCF85063A_PM_IDLE_MS)
+#else
+#define PM_IDLE_DELAY K_NO_WAIT
+#endif
+
+#define PCF85063A_ALARM_FIELDS                                                                     \
+	(RTC_ALARM_TIME_MASK_SECOND | RTC_ALARM_TIME_MASK_MINUTE | RTC_ALARM_TIME_MASK_HOUR |      \
+	 RTC_ALARM_TIME_MASK_MONTHDAY | RTC_ALARM_TIME_MASK_WEEKDAY)
+
+// Value checks of times and alarms, which CONFIG_PCF85063A_VALIDATION can compile out.
+// Buffer sizes and register ranges are always checked.
+#ifdef CONFIG_PCF85063A_VALIDATION
+#define VALIDATE(check) (check)
+#else
+#define VALIDATE(check) true
+#endif
+
 /**
- * @brief Extracts a time component from a string and converts it to BCD format
+ * @brief One queued register transfer
  *
- * This function takes a time string (typically in the format "HH:MM:SS")
- * and extracts a two-digit component starting at the specified index.
- * It then converts this component to Binary Coded Decimal (BCD) format.
+ * Operations belonging to the same request are linked through next and are
+ * queued back-to-back; only the last one carries the caller's callback. Each
+ * operation gets the retries, deadline and circuit breaker of a synchronous
+ * transfer.
+ */
+struct rtc_async_op {
+	sys_snode_t node;
+	const struct device *dev;
+	struct i2c_msg msgs[2];
+	uint8_t data[RTC_REGISTER_SIZE + 1]; // Register address followed by the write payload
+	uint8_t *read_buffer;
+	uint8_t size;
+	bool read;
+	struct rtc_async_op *next;
+	uint8_t update_mask;   // Bits of a one-register write to merge into its current value
+	uint8_t base;          // Current value read ahead for update_mask
+	uint32_t start_cycles; // Cycle count when the operation was handed to the bus
+	int64_t deadline;      // Uptime after which no retry is started
+	uint8_t retry;         // Attempts that failed so far
+	bool refused;          // Open circuit breaker, the bus was not touched
+	int result;            // Result of the last attempt
+	rtc_async_callback_t callback;
+	void *user_data;
+};
+
+// Per-instance devicetree configuration
+struct pcf85063a_config {
+	struct i2c_dt_spec i2c;
+	struct gpio_dt_spec int_gpio;
+	struct pcf85063a_bus bus; // Backed by i2c and int_gpio
+	bool cap_12p5pf;          // 12.5 pF quartz load (CAP_SEL), 7 pF otherwise
+};
+
+// Per-instance runtime state
+struct pcf85063a_data {
+	const struct device *dev;
+
+	// Serializes synchronous bus transfers and the register shadow, taken recursively
+	struct k_mutex lock;
+	// An async transfer is on the bus, guarded by lock, async_idle is broadcast once it settled
+	bool async_on_bus;
+	struct k_condvar async_idle;
+
+	// Retry policy and health of synchronous bus transfers, guarded by lock
+	struct rtc_bus_policy bus_policy;
+	struct rtc_breaker breaker;
+
+	// Time block read shared by every caller that asks while it is on the bus
+	struct {
+		struct k_mutex lock;
+		struct k_condvar done;
+		bool in_flight;
+		uint32_t generation; // Bumped each time a result is published
+		rtc_error_t status;
+		uint8_t block[RTC_TIME_REGISTER_SIZE];
+	} time_read;
+
+	// Write-through shadow of the register map, one valid bit per register
+	uint8_t register_shadow[RTC_REGISTER_SIZE];
+	uint32_t shadow_valid;
+
+	// Wall time read from the chip and the CPU cycle count it was read at
+	struct {
+		bool valid;
+		int64_t epoch_ms;
+		uint64_t cycles;
+	} fast_now_anchor;
+	struct k_spinlock fast_now_lock;
+
+	sys_slist_t async_pending;
+	bool async_busy;
+	struct k_spinlock async_lock;
+	struct k_work_delayable async_submit_work; // Hands the head to the bus, after a backoff
+	struct k_work async_done_work;             // Settles the head once it left the bus
+
+#ifdef CONFIG_PCF85063A_INTERRUPT
+	struct gpio_callback gpio_cb;
+	struct k_work_delayable int_work;
+	uint32_t int_cycles; // Cycle count of the INT edge being handled
+	struct pcf85063a_int_latency int_latency;
+	struct k_spinlock int_latency_lock;
+	rtc_timer_handler_t timer_handler;
+	void *timer_user_data;
+#endif
+	bool alarm_pending;
+	rtc_alarm_callback alarm_callback;
+	void *alarm_user_data;
+
+	uint8_t pm_clkout; // COF field to restore on resume, CLKOUT is off while suspended
+	bool int_parked;   // INT pin disconnected while suspended with no interrupt enabled
+
+	// Register file as found at boot, read while the INT GPIO is being set up
+	struct {
+		uint8_t registers[RTC_REGISTER_SIZE];
+		struct k_sem done;
+		rtc_error_t status;
+		bool pending; // Read succeeded and neither RAM_byte nor the time was written since
+	} boot;
+
+#ifdef CONFIG_PCF85063A_DEEP_SLEEP
+	// Wait for the wake-up alarm of pcf85063a_deep_sleep_until()
+	struct {
+		struct k_sem wake;
+		bool active;           // A thread waits for wake
+		bool borrowed;         // AF is the wake-up, not an alarm of the RTC API
+		int64_t woke_uptime;   // Uptime the wake-up alarm was served at
+		int64_t correction_ms; // Kernel time lost in deep sleeps, guarded by fast_now_lock
+	} sleep;
+#endif
+};
+
+// Async operations are shared by all instances
+K_MEM_SLAB_DEFINE_STATIC(async_slab, sizeof(struct rtc_async_op), RTC_ASYNC_QUEUE_DEPTH, 4);
+
+#ifdef CONFIG_PCF85063A_INTERRUPT
+// Interrupt work of all instances runs on one dedicated queue
+K_THREAD_STACK_DEFINE(int_workq_stack, RTC_INT_WORKQ_STACK_SIZE);
+static struct k_work_q int_workq;
+static bool int_workq_started;
+#endif
+
+/**
+ * @brief Bus API: burst read over I2C
  *
- * @param time_str Pointer to the time string
- * @param index Starting index of the time component to extract
- * @return uint8_t The extracted time component in BCD format
+ * @param bus Bus of the instance, its context is the instance config
+ * @param start_address First register to read
+ * @param buffer Pointer to store the registers
+ * @param size Number of registers to read
+ * @return int 0 on success, negative errno otherwise
  */
-uint8_t extract_time_component(const char *time_str, int index)
+static int i2c_bus_read(const struct pcf85063a_bus *bus, uint8_t start_address, uint8_t *buffer,
+			uint8_t size)
 {
-	return ((time_str[index] - '0') << BCD_SHIFT) | (time_str[index + 1] - '0');
+	const struct pcf85063a_config *config = bus->ctx;
+
+	return i2c_burst_read_dt(&config->i2c, start_address, buffer, size);
 }
 
 /**
- * @brief Converts a decimal number to Binary Coded Decimal (BCD) format
+ * @brief Bus API: sends every burst as one message of a single I2C transfer
  *
- * This function takes a decimal number (0-99) and converts it to BCD format.
- * In BCD, each decimal digit is encoded in four bits.
+ * @param bus Bus of the instance, its context is the instance config
+ * @param bursts Runs of registers to write, each prefixed with its address on the wire
+ * @param count Number of bursts, at most half the registers plus one
+ * @return int 0 on success, negative errno otherwise
+ */
+static int i2c_bus_write(const struct pcf85063a_bus *bus, const struct pcf85063a_burst *bursts,
+			 size_t count)
+{
+	const struct pcf85063a_config *config = bus->ctx;
+	// Bursts are separated by gaps, so there are at most half the registers of them,
+	// plus the lead burst of a transaction
+	struct i2c_msg msgs[(RTC_REGISTER_SIZE + 1) / 2 + 1];
+	uint8_t wire[RTC_REGISTER_SIZE + ARRAY_SIZE(msgs)];
+	size_t pos = 0;
+
+	if (count == 0 || count > ARRAY_SIZE(msgs)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (pos + 1 + bursts[i].size > sizeof(wire)) {
+			return -EINVAL;
+		}
+		msgs[i].buf = &wire[pos];
+		msgs[i].len = bursts[i].size + 1;
+		msgs[i].flags = I2C_MSG_WRITE | (i > 0 ? I2C_MSG_RESTART : 0);
+		wire[pos++] = bursts[i].start_address;
+		memcpy(&wire[pos], bursts[i].data, bursts[i].size);
+		pos += bursts[i].size;
+	}
+	msgs[count - 1].flags |= I2C_MSG_STOP;
+
+	return i2c_transfer_dt(&config->i2c, msgs, count);
+}
+
+/**
+ * @brief Bus API: connects the INT pin as an edge interrupt input, or disconnects it
  *
- * @param decimal The decimal number to convert (0-99)
- * @return uint8_t The input number in BCD format
+ * @param bus Bus of the instance, its context is the instance config
+ * @param enable True to connect, false to disconnect
+ * @return int 0 on success, negative errno otherwise
  */
-uint8_t convert_to_bcd(uint8_t decimal)
+static int i2c_bus_irq_enable(const struct pcf85063a_bus *bus, bool enable)
 {
-	return ((decimal / 10) << BCD_SHIFT) | (decimal % 10);
+	const struct pcf85063a_config *config = bus->ctx;
+
+	if (!enable) {
+		gpio_pin_interrupt_configure_dt(&config->int_gpio, GPIO_INT_DISABLE);
+		return gpio_pin_configure_dt(&config->int_gpio, GPIO_DISCONNECTED);
+	}
+
+	int ret = gpio_pin_configure_dt(&config->int_gpio, GPIO_INPUT);
+	if (ret != RTC_SUCCESS) {
+		LOG_ERR("Error %d: failed to configure interrupt pin\n", ret);
+		return ret;
+	}
+
+	ret = gpio_pin_interrupt_configure_dt(&config->int_gpio, GPIO_INT_EDGE_TO_ACTIVE);
+	if (ret != RTC_SUCCESS) {
+		LOG_ERR("Error %d: failed to configure interrupt\n", ret);
+		return ret;
+	}
+
+	return 0;
 }
 
+static const struct pcf85063a_bus_api i2c_bus_api = {
+	.read = i2c_bus_read,
+	.write = i2c_bus_write,
+	.irq_enable = i2c_bus_irq_enable,
+};
+
+// One synchronous bus operation, a read if read_buffer is set, a write of the bursts otherwise
+struct bus_request {
+	uint8_t *read_buffer;
+	uint8_t start_address;
+	uint8_t size;
+	const struct pcf85063a_burst *bursts;
+	size_t count;
+};
+
 /**
- * @brief Converts a month name to its corresponding number
+ * @brief Feeds the outcome of a bus operation to the circuit breaker
  *
- * This function takes a three-letter month name (e.g., "Jan", "Feb")
- * and returns the corresponding month number (1-12).
+ * The failure that opens the breaker also recovers the bus.
  *
- * @param month_str Pointer to the month name string (3 characters)
- * @return uint8_t The month number (1-12), or 0 if the month is not recognized
+ * @param dev Pointer to the RTC device
+ * @param ret Result of the operation's last attempt, 0 on success
+ * @note The caller holds the device lock. Synchronous callers took it through
+ *       lock_bounded() or lock_device() and async ones settle a finished
+ *       transfer, so the recovery cuts no transfer of the device short.
  */
-uint8_t find_month(const char *month_str)
+static void breaker_record_locked(const struct device *dev, int ret)
 {
-	const char *months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
-				"Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
-	for (int i = 0; i < 12; i++) {
-		if (strcmp(month_str, months[i]) == 0) {
-			return i + 1;
+	const struct pcf85063a_config *config = dev->config;
+	struct pcf85063a_data *data = dev->data;
+	const struct rtc_bus_policy *policy = &data->bus_policy;
+
+	if (rtc_breaker_record(&data->breaker, policy, ret == 0, k_uptime_get())) {
+		LOG_ERR("Error %d: bus failing, failing fast for %u ms \n", ret, policy->open_ms);
+		const int err = i2c_recover_bus(config->i2c.bus);
+		if (err != 0 && err != -ENOSYS) {
+			LOG_ERR("Error %d: bus recovery failed \n", err);
 		}
 	}
-	return 0;
 }
 
 /**
- * @brief Returns the civic time in BCD format
+ * @brief Runs a bus operation under the retry and circuit breaker policy
+ *
+ * Failed attempts are retried with exponential backoff while the retry budget
+ * and the operation deadline allow. The failure that opens the breaker also
+ * recovers the bus. While the breaker is open, operations fail without
+ * touching the bus, until it lets one probe through.
+ *
+ * @param dev Pointer to the RTC device
+ * @param request Operation to run
+ * @return rtc_error_t RTC_ERROR_BUS_UNAVAILABLE while the breaker is open,
+ *         RTC_ERROR_TIMEOUT if the deadline cut the retries short, otherwise
+ *         RTC_ERROR_I2C_READ or RTC_ERROR_I2C_WRITE if every attempt failed
+ * @note The caller holds the device lock. A single attempt is bounded by the
+ *       I2C controller driver's transfer timeout.
+ */
+static rtc_error_t bus_transfer_locked(const struct device *dev, const struct bus_request *request)
+{
+	const struct pcf85063a_config *config = dev->config;
+	struct pcf85063a_data *data = dev->data;
+	const struct rtc_bus_policy *policy = &data->bus_policy;
+	const bool read = request->read_buffer != NULL;
+	const int64_t deadline = k_uptime_get() + policy->deadline_ms;
+	const uint32_t start = k_cycle_get_32();
+	size_t bytes = request->size;
+	int ret;
+
+	if (!rtc_breaker_allow(&data->breaker, k_uptime_get())) {
+		return RTC_ERROR_BUS_UNAVAILABLE;
+	}
+
+	for (uint8_t retry = 0;; retry++) {
+		if (read) {
+			ret = pcf85063a_bus_read(&config->bus, request->start_address,
+						 request->read_buffer, request->size);
+		} else {
+			ret = pcf85063a_bus_write_bursts(&config->bus, request->bursts,
+							 request->count);
+		}
+		if (ret == 0 || retry == policy->retries) {
+			break;
+		}
+
+		const uint32_t backoff = rtc_retry_backoff_ms(policy, retry);
+		if (k_uptime_get() + backoff >= deadline) {
+			ret = -ETIMEDOUT;
+			break;
+		}
+		k_msleep(backoff);
+	}
+
+	if (!read) {
+		bytes = 0;
+		for (size_t i = 0; i < request->count; i++) {
+			bytes += request->bursts[i].size;
+		}
+	}
+	pcf85063a_stats_record(read ? PCF85063A_STATS_READ : PCF85063A_STATS_WRITE, bytes, ret,
+			       k_cycle_get_32() - start);
+
+	breaker_record_locked(dev, ret);
+
+	if (ret == -ETIMEDOUT) {
+		return RTC_ERROR_TIMEOUT;
+	}
+	if (ret != 0) {
+		return read ? RTC_ERROR_I2C_READ : RTC_ERROR_I2C_WRITE;
+	}
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Reads registers under the bus policy, the caller holds the device lock
+ *
+ * @param dev Pointer to the RTC device
+ * @param start_address First register to read
+ * @param buffer Pointer to store the registers
+ * @param size Number of registers to read
+ * @return rtc_error_t Status of bus_transfer_locked()
+ */
+static rtc_error_t bus_read_locked(const struct device *dev, uint8_t start_address,
+				   uint8_t *buffer, uint8_t size)
+{
+	const struct bus_request request = {
+		.read_buffer = buffer,
+		.start_address = start_address,
+		.size = size,
+	};
+
+	return bus_transfer_locked(dev, &request);
+}
+
+/**
+ * @brief Writes bursts as one transfer under the bus policy, the caller holds the device lock
+ *
+ * @param dev Pointer to the RTC device
+ * @param bursts Runs of registers to write
+ * @param count Number of bursts
+ * @return rtc_error_t Status of bus_transfer_locked()
+ */
+static rtc_error_t bus_write_locked(const struct device *dev, const struct pcf85063a_burst *bursts,
+				    size_t count)
+{
+	const struct bus_request request = {
+		.bursts = bursts,
+		.count = count,
+	};
+
+	return bus_transfer_locked(dev, &request);
+}
+
+/**
+ * @brief Takes the device lock, waiting at most the operation deadline
+ *
+ * An async transfer is handed to the bus under the lock but completes without
+ * it, so this also waits until none is on the bus. A read-modify-write under
+ * the lock can then not lose an async write landing between its two halves.
+ * Taking the lock again while holding it never waits, no async transfer
+ * starts meanwhile.
+ *
+ * @param dev Pointer to the RTC device
+ * @return rtc_error_t RTC_ERROR_TIMEOUT if another operation held the lock or
+ *         the bus the whole time
+ */
+static rtc_error_t lock_bounded(const struct device *dev)
+{
+	struct pcf85063a_data *data = dev->data;
+	const uint32_t deadline_ms = data->bus_policy.deadline_ms;
+	const int64_t deadline = k_uptime_get() + deadline_ms;
+
+	if (k_mutex_lock(&data->lock, K_MSEC(deadline_ms)) != 0) {
+		LOG_ERR("Timed out waiting for the device \n");
+		return RTC_ERROR_TIMEOUT;
+	}
+	while (data->async_on_bus) {
+		const int64_t left_ms = deadline - k_uptime_get();
+
+		if (left_ms <= 0 ||
+		    k_condvar_wait(&data->async_idle, &data->lock, K_MSEC(left_ms)) != 0) {
+			k_mutex_unlock(&data->lock);
+			LOG_ERR("Timed out waiting for an async transfer \n");
+			return RTC_ERROR_TIMEOUT;
+		}
+	}
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Takes the device lock like lock_bounded(), without a time limit
+ *
+ * @param dev Pointer to the RTC device
+ */
+static void lock_device(const struct device *dev)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	while (data->async_on_bus) {
+		k_condvar_wait(&data->async_idle, &data->lock, K_FOREVER);
+	}
+}
+
+/**
+ * @brief Maps a driver status to the errno the RTC API reports
+ *
+ * @param status Driver status of a failed operation
+ * @return int -ETIMEDOUT past the deadline, -EAGAIN while the bus is known bad, -EIO otherwise
+ */
+static int bus_errno(rtc_error_t status)
+{
+	switch (status) {
+	case RTC_ERROR_TIMEOUT:
+		return -ETIMEDOUT;
+	case RTC_ERROR_BUS_UNAVAILABLE:
+		return -EAGAIN;
+	default:
+		return -EIO;
+	}
+}
+
+/**
+ * @brief Copies register contents that are known to be on the chip into the shadow
+ *
+ * A software reset pattern written to Control_1 returns every register to its
+ * reset value, so the whole shadow is dropped instead.
+ *
+ * @param dev Pointer to the RTC device
+ * @param buffer Register contents starting at start_address
+ * @param size Number of registers in buffer
+ * @param start_address First register held in buffer
+ */
+static void shadow_update(const struct device *dev, const uint8_t *buffer, const uint8_t size,
+			  const uint8_t start_address)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	if (start_address == RTC_CONTROL_1_ADDRESS && buffer[0] == RTC_SOFTWARE_RESET) {
+		pcf85063a_cache_invalidate(dev);
+		return;
+	}
+
+	memcpy(&data->register_shadow[start_address], buffer, size);
+	data->shadow_valid |= register_range_mask(start_address, size);
+}
+
+/**
+ * @brief Drops every cached register so the next read of each one goes to the bus
+ *
+ * @param dev Pointer to the RTC device
+ * @note Call this if the chip may have changed behind the driver's back,
+ *       e.g. after a power loss or a reset of the RTC. The register file
+ *       read at boot is dropped as well.
+ */
+void pcf85063a_cache_invalidate(const struct device *dev)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	data->shadow_valid = 0;
+	data->boot.pending = false;
+}
+
+/**
+ * @brief Returns the build time in UTC in BCD format
  *
- * @return uint8_t* Pointer to an array containing:
+ * @return const uint8_t* Pointer to a constant array containing:
  *         Sec, Min, Hr, day(1-31), Weekday, Month, Year
+ * @note The RTC keeps UTC, see PCF85063A_tz.h for local time.
  * @note This is set at time of programming then maintained by RTC.
  *       If RTC power is lost make sure to rebuild and reprogram
- *       not just reprogram to maintain time.
- */
-uint8_t *get_civic_time()
-{
-	const char *time_str = __TIME__;
-	const char *date_str = __DATE__;
-	static uint8_t time_array[7];
-
-	// Extract month
-	char month[DATE_MONTH_END + 1];
-	strncpy(month, date_str, DATE_MONTH_END);
-	month[DATE_MONTH_END] = '\0';
-	uint8_t decimal_month = find_month(month);
-	uint8_t bcd_month = convert_to_bcd(decimal_month);
-
-	// Extract date
-	char date[3];
-	int j = DATE_DAY_START, k = 0;
-	while (date_str[j] != ' ' && k < sizeof(date) - 1) {
-		date[k++] = date_str[j++];
-	}
-	date[k] = '\0';
-	uint8_t decimal_date = atoi(date);
-	uint8_t bcd_date = convert_to_bcd(decimal_date);
-
-	// Extract year
-	char year[YEAR_DIGITS + 1];
-	strncpy(year, &date_str[strlen(date_str) - YEAR_DIGITS], YEAR_DIGITS);
-	year[YEAR_DIGITS] = '\0';
-	uint8_t decimal_year = atoi(year);
-	uint8_t bcd_year = convert_to_bcd(decimal_year);
-
-	// Extract time
-	uint8_t hours = extract_time_component(time_str, TIME_HOURS_INDEX);
-	uint8_t minutes = extract_time_component(time_str, TIME_MINUTES_INDEX);
-	uint8_t seconds = extract_time_component(time_str, TIME_SECONDS_INDEX);
-
-	// Fill time array: sec, min, hr, day(1-31), weekday, month, year
-	time_array[SECONDS_INDEX] = seconds;
-	time_array[MINUTES_INDEX] = minutes;
-	time_array[HOURS_INDEX] = hours;
-	time_array[DATE_INDEX] = bcd_date;
-	time_array[WEEKDAY_INDEX] = 0; // Weekday is not set
-	time_array[MONTH_INDEX] = bcd_month;
-	time_array[YEAR_INDEX] = bcd_year;
+ *       not just reprogram to maintain time. The array is generated
+ *       by the build, see cmake/pcf85063a_build_time.cmake.
+ */
+#ifdef CONFIG_PCF85063A_BUILD_TIME
+const uint8_t *get_civic_time(void)
+{
+	static const uint8_t time_array[RTC_TIME_REGISTER_SIZE] = PCF85063A_BUILD_TIME_BCD;
 
 	return time_array;
 }
+#endif
 
+#ifdef CONFIG_PCF85063A_INTERRUPT
 /**
- * @brief Callback function for alarm interrupt
+ * @brief GPIO ISR for the INT line, stamps the edge and defers to the interrupt queue
  *
  * @param dev Pointer to the device structure
  * @param cb Pointer to the GPIO callback structure
  * @param pins The pin mask for the callback
  */
-static void alarm_callback(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+static void int_gpio_callback(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
 {
-	LOG_INF("Alarm triggered! \n");
-	k_work_submit(&alarm_work);
+	struct pcf85063a_data *data = CONTAINER_OF(cb, struct pcf85063a_data, gpio_cb);
+
+	// Edges arriving while the work is queued are served by it, keep the first stamp
+	if (!k_work_delayable_is_pending(&data->int_work)) {
+		data->int_cycles = k_cycle_get_32();
+	}
+	k_work_reschedule_for_queue(&int_workq, &data->int_work, K_NO_WAIT);
 }
+#endif
 
 /**
- * @brief Set the time for the RTC
+ * @brief Validates a time array before it is written to the time block
  *
  * @param time_array Pointer to an array containing time in format:
  *                   sec, min, hr, day(1-31), weekday, month, year
- * @return rtc_error_t Status of initialization and write
+ * @return rtc_error_t RTC_SUCCESS if the time can be programmed
  */
-rtc_error_t initialize_RTC(const uint8_t *time_array)
+static rtc_error_t check_time(const uint8_t *time_array)
 {
 	if (time_array == NULL) {
 		LOG_ERR("Time array was null \n");
 		return RTC_ERROR_INVALID_PARAMETER;
 	}
 
-	// Validate alarm time values
-	if (time_array[SECONDS_INDEX] > 0x59 || time_array[MINUTES_INDEX] > 0x59 ||
-	    time_array[HOURS_INDEX] > 0x23 || time_array[DATE_INDEX] > 0x31 ||
-	    time_array[WEEKDAY_INDEX] != 0 || time_array[MONTH_INDEX] > 0x12 ||
-	    time_array[YEAR_INDEX] == 0) {
-
+	if (!VALIDATE(rtc_time_block_is_valid(time_array))) {
 		LOG_ERR("Invalid time array values \n");
 		return RTC_ERROR_INVALID_PARAMETER;
 	}
 
-	pcf_85063A = DEVICE_DT_GET(DT_NODELABEL(i2c0));
-	if (!device_is_ready(pcf_85063A)) {
-		LOG_ERR("Error: i2c device is not ready\n");
-		return RTC_ERROR_DEVICE_SETUP;
-	}
+	return RTC_SUCCESS;
+}
 
-	if (!device_is_ready(int_gpio.port)) {
-		LOG_ERR("Error: interrupt GPIO device is not ready\n");
-		return RTC_ERROR_DEVICE_SETUP;
-	}
+/**
+ * @brief Builds the RAM_byte and time block image written by the initialize functions
+ *
+ * @param time_array Pointer to the 7 time registers
+ * @param image Pointer to 8 bytes receiving the warm-boot signature and the time
+ */
+static void init_image(const uint8_t *time_array, uint8_t *image)
+{
+	image[0] = RTC_WARM_BOOT_SIGNATURE;
+	memcpy(&image[1], time_array, RTC_TIME_REGISTER_SIZE);
+}
 
-	int ret = gpio_pin_configure_dt(&int_gpio, GPIO_INPUT);
-	if (ret != RTC_SUCCESS) {
-		LOG_ERR("Error %d: failed to configure interrupt pin\n", ret);
-		return RTC_ERROR_DEVICE_SETUP;
-	}
+/**
+ * @brief Set the time for the RTC
+ *
+ * @param dev Pointer to the RTC device
+ * @param time_array Pointer to an array containing time in format:
+ *                   sec, min, hr, day(1-31), weekday, month, year
+ * @return rtc_error_t Status of initialization and write
+ * @note The bus and interrupt GPIO are brought up by the device init hook.
+ *       RAM_byte is set to RTC_WARM_BOOT_SIGNATURE in the same burst.
+ */
+rtc_error_t pcf85063a_initialize(const struct device *dev, const uint8_t *time_array)
+{
+	uint8_t image[RTC_TIME_REGISTER_SIZE + 1];
 
-	ret = gpio_pin_interrupt_configure_dt(&int_gpio, GPIO_INT_EDGE_TO_ACTIVE);
-	if (ret != RTC_SUCCESS) {
-		LOG_ERR("Error %d: failed to configure interrupt\n", ret);
-		return RTC_ERROR_DEVICE_SETUP;
+	rtc_error_t status = check_time(time_array);
+	if (status != RTC_SUCCESS) {
+		return status;
 	}
 
-	gpio_init_callback(&gpio_cb, alarm_callback, BIT(int_gpio.pin));
-	gpio_add_callback(int_gpio.port, &gpio_cb);
-
-	// Write the time array to the registers
-	ret = i2c_burst_write(pcf_85063A, RTC_ADDRESS, RTC_TIME_REGISTER_ADDRESS, time_array,
-			      RTC_TIME_REGISTER_SIZE);
-
-	if (ret != RTC_SUCCESS) {
-		LOG_ERR("Error %d: i2c burst write failed\n", ret);
-		return RTC_ERROR_I2C_WRITE;
+	if (!device_is_ready(dev)) {
+		LOG_ERR("Error: RTC device is not ready\n");
+		return RTC_ERROR_DEVICE_SETUP;
 	}
 
-	return RTC_SUCCESS;
+	// Write the signature and the time array to the registers
+	init_image(time_array, image);
+	return pcf85063a_write_register(dev, image, sizeof(image), RTC_RAM_BYTE_ADDRESS);
 }
 
 /**
- * @brief Read from specified registers into provided read buffer
+ * @brief Sets the time only if the RTC lost it since it was last initialized
  *
- * @param read_buffer Pointer to the buffer to store read data
- * @param size Number of bytes to read
- * @param start_address Starting address to read from
- * @return rtc_error_t Read status code
- * @note Prints the result
+ * The time is kept when the oscillator never stopped (OS clear), RAM_byte
+ * still holds RTC_WARM_BOOT_SIGNATURE and the time block is a valid calendar
+ * time. The register file read by the device init hook is used for the
+ * check when nothing was written since, so a warm boot costs no bus access.
+ *
+ * @param dev Pointer to the RTC device
+ * @param time_array Pointer to an array containing time in format:
+ *                   sec, min, hr, day(1-31), weekday, month, year
+ * @param warm_boot Set to true if the time was kept, may be NULL
+ * @return rtc_error_t Status of the check and of the write if one was needed
  */
-rtc_error_t read_register(uint8_t *read_buffer, const uint8_t size, const uint8_t start_address)
+rtc_error_t pcf85063a_initialize_warm(const struct device *dev, const uint8_t *time_array,
+				      bool *warm_boot)
 {
-	// Input validation. Buffer is circular so reads beyond 18 are valid, but should not be
-	// allowed for clarity.
-	if (read_buffer == NULL) {
-		LOG_ERR("read_buffer was null \n");
-		return RTC_ERROR_INVALID_PARAMETER;
-	}
+	struct pcf85063a_data *data = dev->data;
+	uint8_t image[RTC_TIME_REGISTER_SIZE + 1];
 
-	if (size <= 0 || size > RTC_REGISTER_SIZE) {
-		LOG_ERR("Invalid size: %d, size must be between 0 and 18 \n", size);
-		return RTC_ERROR_INVALID_PARAMETER;
+	rtc_error_t status = check_time(time_array);
+	if (status != RTC_SUCCESS) {
+		return status;
 	}
 
-	if (start_address < 0 || start_address > RTC_REGISTER_SIZE) {
-		LOG_ERR("Invalid start address: %d, start address must be between 0 and 17 \n",
-			start_address);
-		return RTC_ERROR_INVALID_PARAMETER;
+	if (!device_is_ready(dev)) {
+		LOG_ERR("Error: RTC device is not ready\n");
+		return RTC_ERROR_DEVICE_SETUP;
 	}
 
-	if ((start_address + size) > RTC_REGISTER_SIZE) {
-		LOG_ERR("Invalid read range, outranged RTC registers");
-		return RTC_ERROR_INVALID_PARAMETER;
+	lock_device(dev);
+	const bool from_boot = data->boot.pending;
+	if (from_boot) {
+		memcpy(image, &data->boot.registers[RTC_RAM_BYTE_ADDRESS], sizeof(image));
+		data->boot.pending = false;
 	}
+	k_mutex_unlock(&data->lock);
 
-	uint8_t ret = 0;
-	ret = i2c_burst_read(pcf_85063A, RTC_ADDRESS, start_address, read_buffer, size);
+	if (!from_boot) {
+		status = pcf85063a_read_register(dev, image, sizeof(image), RTC_RAM_BYTE_ADDRESS);
+		if (status != RTC_SUCCESS) {
+			return status;
+		}
+	}
 
-	if (ret != RTC_SUCCESS) {
-		LOG_ERR("Error %d: burst read failed \n", ret);
-		return RTC_ERROR_I2C_WRITE;
+	const bool warm = image[0] == RTC_WARM_BOOT_SIGNATURE &&
+			  !(image[1 + SECONDS_INDEX] & RTC_OSCILLATOR_STOPPED) &&
+			  rtc_time_block_is_valid(&image[1]);
+	if (warm_boot != NULL) {
+		*warm_boot = warm;
 	}
 
-	for (int i = 0; i < size; i++) {
-		LOG_INF("Register[%d]: %02X \n", i, read_buffer[i]);
+	if (warm) {
+		LOG_INF("RTC kept time across reset, time not rewritten \n");
+		return RTC_SUCCESS;
 	}
 
-	return RTC_SUCCESS;
+	return pcf85063a_initialize(dev, time_array);
 }
 
 /**
- * @brief Write to specified registers from provided write buffer
+ * @brief Validates a register buffer and the register range it covers
  *
- * @param write_buffer Pointer to the buffer containing data to write
- * @param size Number of bytes to write
- * @param start_address Starting address to write to
- * @return rtc_error_t Write status code
+ * Buffer is circular so accesses beyond 18 are valid, but should not be
+ * allowed for clarity.
+ *
+ * @param buffer Pointer to the caller's register buffer
+ * @param size Number of bytes to transfer
+ * @param start_address Starting register address
+ * @return rtc_error_t RTC_SUCCESS if the access is allowed
  */
-rtc_error_t write_register(const uint8_t *write_buffer, const uint8_t size,
-			   const uint8_t start_address)
+static rtc_error_t check_register_range(const uint8_t *buffer, const uint8_t size,
+					const uint8_t start_address)
 {
-	// Input validation. Buffer is circular so writes beyond 18 are valid, but should not be
-	// allowed for clarity.
-	if (write_buffer == NULL) {
-		LOG_ERR("Write buffer was null \n");
+	if (buffer == NULL) {
+		LOG_ERR("Register buffer was null \n");
 		return RTC_ERROR_INVALID_PARAMETER;
 	}
 
@@ -275,84 +712,2831 @@ rtc_error_t write_register(const uint8_t *write_buffer, const uint8_t size,
 	}
 
 	if ((start_address + size) > RTC_REGISTER_SIZE) {
-		LOG_ERR("Invalid write range, outranged RTC registers \n");
+		LOG_ERR("Invalid register range, outranged RTC registers \n");
 		return RTC_ERROR_INVALID_PARAMETER;
 	}
 
-	uint8_t ret = 0;
-	ret = i2c_burst_write(pcf_85063A, RTC_ADDRESS, start_address, write_buffer, size);
+	return RTC_SUCCESS;
+}
 
-	if (ret != RTC_SUCCESS) {
-		LOG_ERR("Error %d: burst write failed \n", ret);
-		return RTC_ERROR_I2C_WRITE;
+/**
+ * @brief Records a completed register write in the shadow and dependent state
+ *
+ * @param dev Pointer to the RTC device
+ * @param write_buffer Register contents that were written
+ * @param size Number of registers written
+ * @param start_address First register written
+ */
+static void register_written(const struct device *dev, const uint8_t *write_buffer,
+			     const uint8_t size, const uint8_t start_address)
+{
+	struct pcf85063a_data *data = dev->data;
+	const uint32_t range = register_range_mask(start_address, size);
+
+	shadow_update(dev, write_buffer, size, start_address);
+	if (range & RTC_TIME_REGISTER_MASK) {
+		pcf85063a_fast_now_invalidate(dev);
+	}
+	if (range & (RTC_TIME_REGISTER_MASK | BIT(RTC_RAM_BYTE_ADDRESS))) {
+		data->boot.pending = false;
+	}
+}
+
+/**
+ * @brief Takes a runtime PM reference, resuming the device and its bus if suspended
+ *
+ * @param dev Pointer to the RTC device
+ * @return rtc_error_t RTC_ERROR_DEVICE_SETUP if the device could not be resumed
+ * @note Claim before taking the device lock, the resume action takes it too.
+ */
+static rtc_error_t pm_claim(const struct device *dev)
+{
+	int ret = pm_device_runtime_get(dev);
+	if (ret < 0) {
+		LOG_ERR("Error %d: failed to resume the RTC \n", ret);
+		return RTC_ERROR_DEVICE_SETUP;
 	}
 
 	return RTC_SUCCESS;
 }
 
 /**
- * @brief Placeholder function, currently reads all registers when alarm is called
- * and sets alarm_trigger to true for validation in testing
+ * @brief Drops a runtime PM reference, the device suspends after PM_IDLE_DELAY without use
  *
- * @param work Pointer to the work structure
+ * @param dev Pointer to the RTC device
  */
-static void alarm_work_handler(struct k_work *work)
+static inline void pm_release(const struct device *dev)
 {
-	uint8_t read_buffer[RTC_REGISTER_SIZE] = {0};
-	read_register(read_buffer, RTC_REGISTER_SIZE, 0X00);
-	alarm_trigger = true;
+	pm_device_runtime_put_async(dev, PM_IDLE_DELAY);
 }
 
 /**
- * @brief Set the alarm with a given time in BCD format
+ * @brief Reads registers from the shadow or the bus, the caller holds the device lock
  *
- * @param alarm_buffer Pointer to an array containing:
- *                     Sec, min, hour, day, weekday
- * @param size Size of the alarm_buffer
- * @return rtc_error_t Status of the alarm setting operation
- * @note Triggers interrupt work function when time is reached
+ * @param dev Pointer to the RTC device
+ * @param read_buffer Pointer to the buffer to store read data
+ * @param size Number of bytes to read
+ * @param start_address Starting address to read from
+ * @return rtc_error_t Read status code
  */
-rtc_error_t set_alarm(const uint8_t *alarm_buffer, const size_t size)
+static rtc_error_t read_register_locked(const struct device *dev, uint8_t *read_buffer,
+					const uint8_t size, const uint8_t start_address)
 {
-	// Input validation
-	if (alarm_buffer == NULL) {
-		LOG_ERR("Alarm buffer is NULL \n");
-		return RTC_ERROR_INVALID_PARAMETER;
-	}
+	struct pcf85063a_data *data = dev->data;
+	const uint32_t range = register_range_mask(start_address, size);
 
-	if (size != RTC_ALARM_REGISTER_SIZE) {
-		LOG_ERR("Invalid alarm buffer size. Expected %d, got %d \n",
-			RTC_ALARM_REGISTER_SIZE, size);
-		return RTC_ERROR_INVALID_PARAMETER;
-	}
-
-	// Validate alarm time values
-	if (alarm_buffer[SECONDS_INDEX] > 0x59 || alarm_buffer[MINUTES_INDEX] > 0x59 ||
-	    alarm_buffer[HOURS_INDEX] > 0x23 || alarm_buffer[DATE_INDEX] > 0x31 ||
-	    alarm_buffer[WEEKDAY_INDEX] != 0) {
-		LOG_ERR("Invalid alarm time values \n");
-		return RTC_ERROR_INVALID_PARAMETER;
+	if ((range & RTC_VOLATILE_REGISTERS) == 0 && (data->shadow_valid & range) == range) {
+		memcpy(read_buffer, &data->register_shadow[start_address], size);
+		return RTC_SUCCESS;
 	}
 
-	// Set the control register
-	uint8_t control_2[ALARM_CONTROL_REGISTER], ret = 0;
-	control_2[0] = ENABLE_ALARM;
-	ret = write_register(control_2, sizeof(control_2), ALARM_CONTROL_REGISTER);
+	const rtc_error_t ret = bus_read_locked(dev, start_address, read_buffer, size);
 	if (ret != RTC_SUCCESS) {
-		LOG_ERR("Error: %d. Failed to set alarm control register due to burst write "
-			"failure \n",
-			ret);
-		return RTC_ERROR_I2C_WRITE;
+		LOG_ERR("Error %d: burst read failed \n", ret);
+		return ret;
 	}
 
-	// Set the alarm register
-	ret = write_register(alarm_buffer, size, RTC_ALARM_REGISTER_ADDRESS);
-	if (ret != RTC_SUCCESS) {
-		LOG_ERR("Error: %d. Failed to set alarm time register due to burst write failure "
-			"\n",
-			ret);
-		return RTC_ERROR_I2C_WRITE;
-	}
-	k_work_init(&alarm_work, alarm_work_handler);
+	shadow_update(dev, read_buffer, size, start_address);
 	return RTC_SUCCESS;
 }
+
+/**
+ * @brief Reads the time block, sharing one bus read between concurrent callers
+ *
+ * The first caller becomes the leader and reads the chip. Callers arriving
+ * while that read is pending wait for it and get its result. The leader
+ * publishes the result before giving up the device lock, so a time write
+ * can never land between the read and a caller that joins it.
+ *
+ * @param dev Pointer to the RTC device
+ * @param time_block Pointer to store the 7 time registers
+ * @return rtc_error_t Status of the shared read, RTC_ERROR_TIMEOUT if it took
+ *         longer than the leader can, waiting for the device and then the bus
+ * @note The caller must not hold the device lock, a leader in another thread
+ *       would wait for it while the caller waits for the leader.
+ */
+static rtc_error_t read_time_block_shared(const struct device *dev, uint8_t *time_block)
+{
+	struct pcf85063a_data *data = dev->data;
+	rtc_error_t ret;
+
+	k_mutex_lock(&data->time_read.lock, K_FOREVER);
+	if (data->time_read.in_flight) {
+		const uint32_t generation = data->time_read.generation;
+		const int64_t deadline = k_uptime_get() + 2 * data->bus_policy.deadline_ms;
+
+		while (data->time_read.generation == generation) {
+			const int64_t remaining = deadline - k_uptime_get();
+
+			if (remaining <= 0 ||
+			    k_condvar_wait(&data->time_read.done, &data->time_read.lock,
+					   K_MSEC(remaining)) != 0) {
+				k_mutex_unlock(&data->time_read.lock);
+				return RTC_ERROR_TIMEOUT;
+			}
+		}
+		ret = data->time_read.status;
+		memcpy(time_block, data->time_read.block, RTC_TIME_REGISTER_SIZE);
+		k_mutex_unlock(&data->time_read.lock);
+		return ret;
+	}
+	data->time_read.in_flight = true;
+	k_mutex_unlock(&data->time_read.lock);
+
+	ret = lock_bounded(dev);
+	const bool locked = ret == RTC_SUCCESS;
+	if (locked) {
+		ret = read_register_locked(dev, time_block, RTC_TIME_REGISTER_SIZE,
+					   RTC_TIME_REGISTER_ADDRESS);
+	}
+
+	k_mutex_lock(&data->time_read.lock, K_FOREVER);
+	data->time_read.status = ret;
+	memcpy(data->time_read.block, time_block, RTC_TIME_REGISTER_SIZE);
+	data->time_read.in_flight = false;
+	data->time_read.generation++;
+	k_condvar_broadcast(&data->time_read.done);
+	k_mutex_unlock(&data->time_read.lock);
+
+	if (locked) {
+		k_mutex_unlock(&data->lock);
+	}
+	return ret;
+}
+
+/**
+ * @brief Read from specified registers into provided read buffer
+ *
+ * @param dev Pointer to the RTC device
+ * @param read_buffer Pointer to the buffer to store read data
+ * @param size Number of bytes to read
+ * @param start_address Starting address to read from
+ * @return rtc_error_t Read status code
+ * @note Prints the result. Ranges without volatile registers are served from
+ *       the register shadow once every register in them has been seen.
+ *       Concurrent reads of the whole time block share one bus transfer, so
+ *       code holding the device lock reads through read_register_locked() instead.
+ */
+rtc_error_t pcf85063a_read_register(const struct device *dev, uint8_t *read_buffer,
+				    const uint8_t size, const uint8_t start_address)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	rtc_error_t status = check_register_range(read_buffer, size, start_address);
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+
+	status = pm_claim(dev);
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+
+	if (start_address == RTC_TIME_REGISTER_ADDRESS && size == RTC_TIME_REGISTER_SIZE) {
+		status = read_time_block_shared(dev, read_buffer);
+	} else {
+		status = lock_bounded(dev);
+		if (status == RTC_SUCCESS) {
+			status = read_register_locked(dev, read_buffer, size, start_address);
+			k_mutex_unlock(&data->lock);
+		}
+	}
+	pm_release(dev);
+
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+
+	for (int i = 0; i < size; i++) {
+		LOG_DBG("Register[%d]: %02X \n", i, read_buffer[i]);
+	}
+
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Write to specified registers from provided write buffer
+ *
+ * @param dev Pointer to the RTC device
+ * @param write_buffer Pointer to the buffer containing data to write
+ * @param size Number of bytes to write
+ * @param start_address Starting address to write to
+ * @return rtc_error_t Write status code
+ */
+rtc_error_t pcf85063a_write_register(const struct device *dev, const uint8_t *write_buffer,
+				     const uint8_t size, const uint8_t start_address)
+{
+	struct pcf85063a_data *data = dev->data;
+	const struct pcf85063a_burst burst = {start_address, size, write_buffer};
+
+	rtc_error_t status = check_register_range(write_buffer, size, start_address);
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+
+	status = pm_claim(dev);
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+	status = lock_bounded(dev);
+	if (status != RTC_SUCCESS) {
+		pm_release(dev);
+		return status;
+	}
+
+	status = bus_write_locked(dev, &burst, 1);
+	if (status == RTC_SUCCESS) {
+		register_written(dev, write_buffer, size, start_address);
+	}
+
+	k_mutex_unlock(&data->lock);
+	pm_release(dev);
+
+	if (status != RTC_SUCCESS) {
+		LOG_ERR("Error %d: burst write failed \n", status);
+		return status;
+	}
+
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Sets the deadline, retry and circuit breaker policy of bus operations
+ *
+ * @param dev Pointer to the RTC device
+ * @param policy New policy, the deadline and the trip threshold must not be 0
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER for a policy that can never succeed
+ * @note Takes effect with the next operation, the breaker state is kept.
+ */
+rtc_error_t pcf85063a_set_bus_policy(const struct device *dev, const struct rtc_bus_policy *policy)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	if (policy == NULL || policy->deadline_ms == 0 || policy->trip_failures == 0) {
+		LOG_ERR("Invalid bus policy \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	data->bus_policy = *policy;
+	k_mutex_unlock(&data->lock);
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Returns the circuit breaker of the bus, e.g. for health reporting
+ *
+ * @param dev Pointer to the RTC device
+ * @param breaker Pointer to store the breaker state and counters
+ * @return rtc_error_t RTC_ERROR_TIMEOUT if the device stayed busy past the deadline
+ */
+rtc_error_t pcf85063a_get_bus_health(const struct device *dev, struct rtc_breaker *breaker)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	if (breaker == NULL) {
+		LOG_ERR("breaker was null \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	rtc_error_t status = lock_bounded(dev);
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+	*breaker = data->breaker;
+	k_mutex_unlock(&data->lock);
+	return RTC_SUCCESS;
+}
+
+/*
+ * Transaction builder. Writes and masked updates are staged on a register
+ * image. The commit resolves masked updates from the shadow wherever the chip
+ * cannot have changed the other bits, merges the staged registers into runs,
+ * and sends every run as one burst of a single multi-message I2C transfer.
+ */
+
+// Registers the chip changes on its own, masked updates to them need a bus read
+#define TXN_FETCH_REGISTERS (RTC_VOLATILE_REGISTERS & ~BIT(RTC_CONTROL_2_ADDRESS))
+// Control_2 bits only software changes, the flags clear on 0 and ignore a 1
+#define TXN_CONTROL_2_FLAGS (RTC_CTRL2_AF | RTC_CTRL2_TF)
+// Gaps of up to this many cached registers are rewritten to join two runs
+#define TXN_BRIDGE_MAX 2
+
+/**
+ * @brief Starts an empty transaction
+ *
+ * @param txn Transaction to set up
+ * @param dev Pointer to the RTC device the transaction is committed to
+ */
+void pcf85063a_txn_init(struct pcf85063a_txn *txn, const struct device *dev)
+{
+	memset(txn, 0, sizeof(*txn));
+	txn->dev = dev;
+}
+
+/**
+ * @brief Stages a write of whole registers
+ *
+ * @param txn Transaction
+ * @param write_buffer Values starting at start_address
+ * @param size Number of registers
+ * @param start_address First register
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER for an invalid range
+ */
+rtc_error_t pcf85063a_txn_write(struct pcf85063a_txn *txn, const uint8_t *write_buffer,
+				const uint8_t size, const uint8_t start_address)
+{
+	rtc_error_t status = check_register_range(write_buffer, size, start_address);
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+
+	const uint32_t range = register_range_mask(start_address, size);
+
+	memcpy(&txn->image[start_address], write_buffer, size);
+	txn->dirty |= range;
+	txn->known |= range;
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Stages a read-modify-write of some bits of one register
+ *
+ * @param txn Transaction
+ * @param address Register to update
+ * @param mask Bits to change
+ * @param value New values of the bits in mask
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER for an invalid register
+ */
+rtc_error_t pcf85063a_txn_update(struct pcf85063a_txn *txn, const uint8_t address,
+				 const uint8_t mask, const uint8_t value)
+{
+	if (address >= RTC_REGISTER_SIZE) {
+		LOG_ERR("Invalid register 0x%02X \n", address);
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	txn->image[address] = (txn->image[address] & ~mask) | (value & mask);
+	txn->update_mask[address] |= mask;
+	txn->dirty |= BIT(address);
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Fills in the untouched bits of registers staged with pcf85063a_txn_update()
+ *
+ * @param txn Transaction
+ * @return rtc_error_t Status of the read, if one was needed
+ */
+static rtc_error_t txn_resolve_updates(struct pcf85063a_txn *txn)
+{
+	struct pcf85063a_data *data = txn->dev->data;
+	const uint32_t partial = txn->dirty & ~txn->known;
+	const uint32_t fetch = partial & (TXN_FETCH_REGISTERS | ~data->shadow_valid);
+	uint8_t current[RTC_REGISTER_SIZE];
+
+	if (partial == 0) {
+		return RTC_SUCCESS;
+	}
+
+	memcpy(current, data->register_shadow, sizeof(current));
+	if (fetch != 0) {
+		const uint8_t first = __builtin_ctz(fetch);
+		const uint8_t last = 31 - __builtin_clz(fetch);
+
+		rtc_error_t ret = read_register_locked(txn->dev, &current[first],
+						       last - first + 1, first);
+		if (ret != RTC_SUCCESS) {
+			return ret;
+		}
+	}
+
+	if (partial & BIT(RTC_CONTROL_2_ADDRESS)) {
+		current[RTC_CONTROL_2_ADDRESS] |= TXN_CONTROL_2_FLAGS;
+	}
+
+	for (uint8_t reg = 0; reg < RTC_REGISTER_SIZE; reg++) {
+		if (partial & BIT(reg)) {
+			txn->image[reg] = (current[reg] & ~txn->update_mask[reg]) |
+					  (txn->image[reg] & txn->update_mask[reg]);
+		}
+	}
+	txn->known |= partial;
+
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Joins runs separated by a few registers whose values are cached
+ *
+ * Rewriting a register with its own value costs a byte on the wire, a new
+ * burst costs a repeated start, the address and the register pointer.
+ *
+ * @param txn Transaction
+ */
+static void txn_bridge_gaps(struct pcf85063a_txn *txn)
+{
+	struct pcf85063a_data *data = txn->dev->data;
+	const uint32_t bridgeable = data->shadow_valid & ~RTC_VOLATILE_REGISTERS;
+	uint8_t reg = __builtin_ctz(txn->dirty);
+
+	while (reg < RTC_REGISTER_SIZE) {
+		// Find the end of this run and the start of the next one
+		while (reg < RTC_REGISTER_SIZE && (txn->dirty & BIT(reg))) {
+			reg++;
+		}
+		uint8_t next = reg;
+		while (next < RTC_REGISTER_SIZE && !(txn->dirty & BIT(next))) {
+			next++;
+		}
+		if (next == RTC_REGISTER_SIZE) {
+			return;
+		}
+
+		const uint32_t gap = register_range_mask(reg, next - reg);
+		if (next - reg <= TXN_BRIDGE_MAX && (gap & bridgeable) == gap) {
+			memcpy(&txn->image[reg], &data->register_shadow[reg], next - reg);
+			txn->dirty |= gap;
+			txn->known |= gap;
+		}
+		reg = next;
+	}
+}
+
+/**
+ * @brief Sends a transaction, the caller holds the device lock
+ *
+ * @param txn Transaction
+ * @param lead Burst sent ahead of the staged registers in the same transfer, may be NULL.
+ *             It may write a register the transaction writes again.
+ * @return rtc_error_t Status of the transfer
+ */
+static rtc_error_t txn_commit_locked(struct pcf85063a_txn *txn,
+				     const struct pcf85063a_burst *lead)
+{
+	const struct device *dev = txn->dev;
+	// Runs alternate with gaps, so there are at most half the registers of them, plus lead
+	struct pcf85063a_burst bursts[(RTC_REGISTER_SIZE + 1) / 2 + 1];
+	size_t num_bursts = 0;
+
+	rtc_error_t ret = txn_resolve_updates(txn);
+	if (ret != RTC_SUCCESS || txn->dirty == 0) {
+		pcf85063a_txn_init(txn, dev);
+		return ret;
+	}
+
+	if (lead != NULL) {
+		bursts[num_bursts++] = *lead;
+	}
+
+	txn_bridge_gaps(txn);
+
+	for (uint8_t reg = 0; reg < RTC_REGISTER_SIZE;) {
+		if (!(txn->dirty & BIT(reg))) {
+			reg++;
+			continue;
+		}
+
+		uint8_t end = reg;
+		while (end < RTC_REGISTER_SIZE && (txn->dirty & BIT(end))) {
+			end++;
+		}
+
+		bursts[num_bursts].start_address = reg;
+		bursts[num_bursts].size = end - reg;
+		bursts[num_bursts].data = &txn->image[reg];
+		num_bursts++;
+		reg = end;
+	}
+
+	ret = bus_write_locked(dev, bursts, num_bursts);
+	if (ret != RTC_SUCCESS) {
+		LOG_ERR("Error %d: transaction of %d bursts failed \n", ret, num_bursts);
+	} else {
+		for (size_t i = 0; i < num_bursts; i++) {
+			register_written(dev, bursts[i].data, bursts[i].size,
+					 bursts[i].start_address);
+		}
+	}
+
+	pcf85063a_txn_init(txn, dev);
+	return ret;
+}
+
+/**
+ * @brief Writes every staged register in as few bursts as possible
+ *
+ * Each run of consecutive registers becomes one write message. All messages go
+ * out in a single i2c_transfer with a repeated start between them. The
+ * transaction is empty again afterwards, whatever the result.
+ *
+ * @param txn Transaction
+ * @return rtc_error_t Status of the transfer
+ * @note The device lock is held from resolving the updates to the transfer,
+ *       so the read-modify-writes cannot interleave with other writers.
+ */
+rtc_error_t pcf85063a_txn_commit(struct pcf85063a_txn *txn)
+{
+	const struct device *dev = txn->dev;
+	struct pcf85063a_data *data = dev->data;
+
+	rtc_error_t ret = pm_claim(dev);
+	if (ret != RTC_SUCCESS) {
+		pcf85063a_txn_init(txn, dev);
+		return ret;
+	}
+
+	ret = lock_bounded(dev);
+	if (ret == RTC_SUCCESS) {
+		ret = txn_commit_locked(txn, NULL);
+		k_mutex_unlock(&data->lock);
+	} else {
+		pcf85063a_txn_init(txn, dev);
+	}
+
+	pm_release(dev);
+	return ret;
+}
+
+#ifdef CONFIG_PCF85063A_INTERRUPT
+/**
+ * @brief Adds one edge-to-completion latency to the histogram
+ *
+ * @param data Per-instance runtime state
+ * @param cycles Latency in CPU cycles
+ */
+static void int_latency_record(struct pcf85063a_data *data, uint32_t cycles)
+{
+	// Bucket i holds latencies of 2^i up to 2^(i + 1) - 1 cycles
+	const uint32_t bucket = 31 - __builtin_clz(cycles | 1);
+
+	k_spinlock_key_t key = k_spin_lock(&data->int_latency_lock);
+	data->int_latency.buckets[bucket]++;
+	data->int_latency.count++;
+	data->int_latency.max_cycles = MAX(data->int_latency.max_cycles, cycles);
+	k_spin_unlock(&data->int_latency_lock, key);
+}
+
+/**
+ * @brief Reads Control_2 and clears the alarm and timer flags found set
+ *
+ * Control_2 is fetched with one write-read and the flags are cleared with one
+ * byte write, both under the device lock. Flags are only reported once they
+ * are cleared, as INT stays asserted and no further edge comes until then.
+ *
+ * @param dev Pointer to the RTC device
+ * @param flags Pointer to store the AF and TF bits that were set
+ * @return int 0 on success, -EIO if Control_2 could not be read or cleared
+ */
+static int int_take_flags(const struct device *dev, uint8_t *flags)
+{
+	struct pcf85063a_data *data = dev->data;
+	uint8_t control_2;
+
+	*flags = 0;
+	if (pm_claim(dev) != RTC_SUCCESS) {
+		return -EIO;
+	}
+	lock_device(dev);
+
+	int ret = 0;
+	if (bus_read_locked(dev, RTC_CONTROL_2_ADDRESS, &control_2, sizeof(control_2)) !=
+	    RTC_SUCCESS) {
+		ret = -EIO;
+	}
+	if (ret == 0) {
+		*flags = control_2 & (RTC_CTRL2_AF | RTC_CTRL2_TF);
+	}
+	if (*flags != 0) {
+		// Writing 1 to a flag leaves it untouched, so only the seen flags are cleared
+		control_2 = (control_2 | RTC_CTRL2_AF | RTC_CTRL2_TF) & ~*flags;
+		const struct pcf85063a_burst burst = {RTC_CONTROL_2_ADDRESS, sizeof(control_2),
+						      &control_2};
+
+		if (bus_write_locked(dev, &burst, 1) == RTC_SUCCESS) {
+			register_written(dev, &control_2, sizeof(control_2), RTC_CONTROL_2_ADDRESS);
+		} else {
+			*flags = 0;
+			ret = -EIO;
+		}
+	}
+
+	k_mutex_unlock(&data->lock);
+	pm_release(dev);
+	return ret;
+}
+
+#ifdef CONFIG_PCF85063A_DEEP_SLEEP
+static bool deep_sleep_wake(struct pcf85063a_data *data);
+#else
+static inline bool deep_sleep_wake(struct pcf85063a_data *data)
+{
+	ARG_UNUSED(data);
+	return false;
+}
+#endif
+
+/**
+ * @brief Serves an INT edge on the interrupt queue
+ *
+ * The alarm and timer flags found set are cleared, then reported to the alarm
+ * callback registered through the RTC API and the countdown timer handler.
+ * Handlers run without the device lock held. The time from the edge to the
+ * end of the handlers goes into the latency histogram. If Control_2 cannot be
+ * read or cleared, INT stays asserted without a new edge, so the work item
+ * retries once the bus breaker lets a probe through.
+ *
+ * @param work Pointer to the work structure
+ */
+static void int_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct pcf85063a_data *data = CONTAINER_OF(dwork, struct pcf85063a_data, int_work);
+	const struct device *dev = data->dev;
+	uint8_t flags;
+
+	int ret = int_take_flags(dev, &flags);
+	if (ret != 0) {
+		LOG_ERR("Error %d: failed to serve Control_2 for an interrupt \n", ret);
+		pcf85063a_stats_record(PCF85063A_STATS_INT, 0, ret, k_cycle_get_32() - data->int_cycles);
+
+		k_mutex_lock(&data->lock, K_FOREVER);
+		const uint32_t retry_ms = data->bus_policy.open_ms;
+		k_mutex_unlock(&data->lock);
+		k_work_reschedule_for_queue(&int_workq, dwork, K_MSEC(retry_ms));
+		return;
+	}
+
+	if (flags == 0) {
+		return;
+	}
+
+	if ((flags & RTC_CTRL2_AF) && !deep_sleep_wake(data)) {
+		data->alarm_pending = true;
+		alarm_trigger = true;
+		if (data->alarm_callback != NULL) {
+			data->alarm_callback(dev, 0, data->alarm_user_data);
+		}
+	}
+
+	rtc_timer_handler_t timer_handler = data->timer_handler;
+	if ((flags & RTC_CTRL2_TF) && timer_handler != NULL) {
+		timer_handler(dev, data->timer_user_data);
+	}
+
+	const uint32_t latency = k_cycle_get_32() - data->int_cycles;
+	int_latency_record(data, latency);
+	pcf85063a_stats_record(PCF85063A_STATS_INT, 0, 0, latency);
+}
+
+/**
+ * @brief Copies the interrupt latency histogram
+ *
+ * @param dev Pointer to the RTC device
+ * @param latency Pointer to store the histogram
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER if latency is NULL
+ * @note Latencies are CPU cycles from the INT edge to the return of the last
+ *       handler, convert with k_cyc_to_us_near32().
+ */
+rtc_error_t pcf85063a_get_int_latency(const struct device *dev,
+				      struct pcf85063a_int_latency *latency)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	if (latency == NULL) {
+		LOG_ERR("latency was null \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&data->int_latency_lock);
+	*latency = data->int_latency;
+	k_spin_unlock(&data->int_latency_lock, key);
+
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Empties the interrupt latency histogram
+ *
+ * @param dev Pointer to the RTC device
+ */
+void pcf85063a_reset_int_latency(const struct device *dev)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	k_spinlock_key_t key = k_spin_lock(&data->int_latency_lock);
+	memset(&data->int_latency, 0, sizeof(data->int_latency));
+	k_spin_unlock(&data->int_latency_lock, key);
+}
+#endif /* CONFIG_PCF85063A_INTERRUPT */
+
+#ifdef CONFIG_PCF85063A_ALARM
+/**
+ * @brief Validates an alarm buffer
+ *
+ * @param alarm_buffer Pointer to an array containing:
+ *                     Sec, min, hour, day, weekday
+ * @param size Size of the alarm_buffer
+ * @return rtc_error_t RTC_SUCCESS if the alarm can be programmed
+ */
+static rtc_error_t check_alarm(const uint8_t *alarm_buffer, const size_t size)
+{
+	if (alarm_buffer == NULL) {
+		LOG_ERR("Alarm buffer is NULL \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	if (size != RTC_ALARM_REGISTER_SIZE) {
+		LOG_ERR("Invalid alarm buffer size. Expected %d, got %d \n",
+			RTC_ALARM_REGISTER_SIZE, size);
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	if (!VALIDATE(rtc_alarm_block_is_valid(alarm_buffer))) {
+		LOG_ERR("Invalid alarm time values \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Arms or disarms the alarm and writes the alarm block in one transaction
+ *
+ * @param dev Pointer to the RTC device
+ * @param alarm_buffer Pointer to the 5 alarm registers to write
+ * @param enable True to set AIE, false to clear it
+ * @return rtc_error_t Status of the transaction
+ * @note A stale AF is cleared, the other Control_2 bits are left as they are.
+ */
+static rtc_error_t write_alarm(const struct device *dev, const uint8_t *alarm_buffer,
+			       const bool enable)
+{
+	struct pcf85063a_txn txn;
+
+	pcf85063a_txn_init(&txn, dev);
+	pcf85063a_txn_update(&txn, RTC_CONTROL_2_ADDRESS, RTC_CTRL2_AIE | RTC_CTRL2_AF,
+			     enable ? RTC_CTRL2_AIE : 0);
+	pcf85063a_txn_write(&txn, alarm_buffer, RTC_ALARM_REGISTER_SIZE,
+			    RTC_ALARM_REGISTER_ADDRESS);
+
+	rtc_error_t ret = pcf85063a_txn_commit(&txn);
+	if (ret != RTC_SUCCESS) {
+		LOG_ERR("Error: %d. Failed to write the alarm \n", ret);
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Set the alarm with a given time in BCD format
+ *
+ * @param dev Pointer to the RTC device
+ * @param alarm_buffer Pointer to an array containing:
+ *                     Sec, min, hour, day, weekday
+ * @param size Size of the alarm_buffer
+ * @return rtc_error_t Status of the alarm setting operation
+ * @note Triggers interrupt work function when time is reached. A field with
+ *       RTC_ALARM_FIELD_DISABLE set is left out of the match, so the alarm
+ *       fires again every time the enabled fields match.
+ */
+rtc_error_t pcf85063a_set_alarm(const struct device *dev, const uint8_t *alarm_buffer,
+				const size_t size)
+{
+	rtc_error_t status = check_alarm(alarm_buffer, size);
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+
+	return write_alarm(dev, alarm_buffer, true);
+}
+
+/**
+ * @brief Programs an alarm that the chip repeats on its own
+ *
+ * The fields finer than the period are matched and the coarser ones are
+ * disabled through their AEN bits, so after this one write the alarm fires
+ * every period with no further bus traffic than the AF clear per interrupt.
+ *
+ * @param dev Pointer to the RTC device
+ * @param repeat Repeat period
+ * @param day Weekday 0-6 for RTC_ALARM_WEEKLY, date 1-31 for RTC_ALARM_MONTHLY, ignored otherwise
+ * @param hour Hour 0-23, ignored for RTC_ALARM_EVERY_MINUTE and RTC_ALARM_HOURLY
+ * @param minute Minute 0-59, ignored for RTC_ALARM_EVERY_MINUTE
+ * @param second Second 0-59
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER for an unknown period or a
+ *         value out of range, otherwise the status of the alarm write
+ */
+rtc_error_t pcf85063a_set_recurring_alarm(const struct device *dev, rtc_alarm_repeat_t repeat,
+					  uint8_t day, uint8_t hour, uint8_t minute, uint8_t second)
+{
+	uint8_t alarm_buffer[RTC_ALARM_REGISTER_SIZE] = {
+		RTC_ALARM_FIELD_DISABLE, RTC_ALARM_FIELD_DISABLE, RTC_ALARM_FIELD_DISABLE,
+		RTC_ALARM_FIELD_DISABLE, RTC_ALARM_FIELD_DISABLE,
+	};
+
+	if (repeat > RTC_ALARM_MONTHLY ||
+	    !VALIDATE(second <= 59 && (repeat < RTC_ALARM_HOURLY || minute <= 59) &&
+		      (repeat < RTC_ALARM_DAILY || hour <= 23) &&
+		      (repeat != RTC_ALARM_WEEKLY || day <= 6) &&
+		      (repeat != RTC_ALARM_MONTHLY || (day >= 1 && day <= 31)))) {
+		LOG_ERR("Invalid recurring alarm %d at %d %02d:%02d:%02d \n", repeat, day, hour,
+			minute, second);
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	alarm_buffer[SECONDS_INDEX] = convert_to_bcd(second);
+	if (repeat >= RTC_ALARM_HOURLY) {
+		alarm_buffer[MINUTES_INDEX] = convert_to_bcd(minute);
+	}
+	if (repeat >= RTC_ALARM_DAILY) {
+		alarm_buffer[HOURS_INDEX] = convert_to_bcd(hour);
+	}
+	if (repeat == RTC_ALARM_WEEKLY) {
+		alarm_buffer[WEEKDAY_INDEX] = day;
+	} else if (repeat == RTC_ALARM_MONTHLY) {
+		alarm_buffer[DATE_INDEX] = convert_to_bcd(day);
+	}
+
+	return write_alarm(dev, alarm_buffer, true);
+}
+#endif /* CONFIG_PCF85063A_ALARM */
+
+/**
+ * @brief Reprograms the countdown timer, the caller holds the device lock
+ *
+ * The stop, the Control_2 update and the reload go out as one transfer, the
+ * stop first so the new period is not mixed with the old one.
+ *
+ * @param dev Pointer to the RTC device
+ * @param timer_block Timer_value and Timer_mode to write
+ * @param handler Function called on every tick, may be NULL
+ * @param user_data Pointer passed to handler
+ * @return rtc_error_t Status of the transaction
+ */
+static rtc_error_t timer_start_locked(const struct device *dev, const uint8_t *timer_block,
+				      rtc_timer_handler_t handler, void *user_data)
+{
+	struct pcf85063a_data *data = dev->data;
+	// Timer disabled on the slowest source clock, as pcf85063a_timer_stop() leaves it
+	const uint8_t timer_stop = RTC_TIMER_CLOCK_1_60HZ << RTC_TIMER_MODE_TCF_SHIFT;
+	const struct pcf85063a_burst stop = {
+		.start_address = RTC_TIMER_MODE_ADDRESS,
+		.size = sizeof(timer_stop),
+		.data = &timer_stop,
+	};
+	struct pcf85063a_txn txn;
+
+	// Drop a tick left over from before, the commit leaves AF untouched
+	pcf85063a_txn_init(&txn, dev);
+	pcf85063a_txn_update(&txn, RTC_CONTROL_2_ADDRESS, RTC_CTRL2_TF, 0);
+	pcf85063a_txn_write(&txn, timer_block, 2, RTC_TIMER_VALUE_ADDRESS);
+
+#ifdef CONFIG_PCF85063A_INTERRUPT
+	data->timer_handler = handler;
+	data->timer_user_data = user_data;
+#else
+	ARG_UNUSED(data);
+	ARG_UNUSED(handler);
+	ARG_UNUSED(user_data);
+#endif
+
+	return txn_commit_locked(&txn, &stop);
+}
+
+/**
+ * @brief Starts the countdown timer as a periodic tick
+ *
+ * The timer counts reload periods of the source clock, raises TF, reloads and
+ * keeps going. Every expiry asserts INT, which wakes the SoC through the
+ * interrupt GPIO without any high-frequency timer running.
+ *
+ * @param dev Pointer to the RTC device
+ * @param clock Source clock of the countdown
+ * @param reload Number of source clock periods per tick, 1-255
+ * @param pulse True for a short INT pulse per tick, false to hold INT until TF is cleared
+ * @param handler Function called from the interrupt work item on every tick, may be NULL.
+ *        Must be NULL without CONFIG_PCF85063A_INTERRUPT.
+ * @param user_data Pointer passed to handler
+ * @return rtc_error_t Status of the register writes
+ * @note The tick period is reload / clock, e.g. 60 s is RTC_TIMER_CLOCK_1HZ with reload 60.
+ */
+rtc_error_t pcf85063a_timer_start(const struct device *dev, rtc_timer_clock_t clock, uint8_t reload,
+				  bool pulse, rtc_timer_handler_t handler, void *user_data)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	if (clock > RTC_TIMER_CLOCK_1_60HZ || reload == 0) {
+		LOG_ERR("Invalid timer clock %d or reload %d \n", clock, reload);
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+	if (!IS_ENABLED(CONFIG_PCF85063A_INTERRUPT) && handler != NULL) {
+		LOG_ERR("Timer handlers need CONFIG_PCF85063A_INTERRUPT \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	const uint8_t timer_block[2] = {
+		reload,
+		(clock << RTC_TIMER_MODE_TCF_SHIFT) | RTC_TIMER_MODE_TE | RTC_TIMER_MODE_TIE |
+			(pulse ? RTC_TIMER_MODE_TI_TP : 0),
+	};
+
+	rtc_error_t ret = pm_claim(dev);
+	if (ret != RTC_SUCCESS) {
+		return ret;
+	}
+
+	lock_device(dev);
+	ret = timer_start_locked(dev, timer_block, handler, user_data);
+	k_mutex_unlock(&data->lock);
+
+	pm_release(dev);
+	return ret;
+}
+
+/**
+ * @brief Stops the countdown timer and its interrupt
+ *
+ * @param dev Pointer to the RTC device
+ * @return rtc_error_t Status of the register write
+ */
+rtc_error_t pcf85063a_timer_stop(const struct device *dev)
+{
+	struct pcf85063a_data *data = dev->data;
+	// Timer disabled on the slowest source clock, the reset value and the lowest current
+	const uint8_t timer_mode = RTC_TIMER_CLOCK_1_60HZ << RTC_TIMER_MODE_TCF_SHIFT;
+
+	rtc_error_t ret = pm_claim(dev);
+	if (ret != RTC_SUCCESS) {
+		return ret;
+	}
+	lock_device(dev);
+
+	ret = pcf85063a_write_register(dev, &timer_mode, sizeof(timer_mode),
+				       RTC_TIMER_MODE_ADDRESS);
+#ifdef CONFIG_PCF85063A_INTERRUPT
+	if (ret == RTC_SUCCESS) {
+		data->timer_handler = NULL;
+		data->timer_user_data = NULL;
+	}
+#endif
+
+	k_mutex_unlock(&data->lock);
+	pm_release(dev);
+	return ret;
+}
+
+/**
+ * @brief Converts a time block read from the chip to seconds since the Unix epoch
+ *
+ * @param time_block Time registers as read from the chip
+ * @param epoch Pointer to store the seconds since the Unix epoch
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER if the chip holds an invalid time
+ */
+static rtc_error_t epoch_from_time_block(const uint8_t *time_block, int64_t *epoch)
+{
+	if (!rtc_time_block_is_valid(time_block)) {
+		LOG_ERR("RTC holds an invalid time \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	*epoch = rtc_time_block_to_epoch(time_block);
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Reads the current time as seconds since 1970-01-01 00:00:00
+ *
+ * @param dev Pointer to the RTC device
+ * @param epoch Pointer to store the seconds since the Unix epoch
+ * @return rtc_error_t Read status code, RTC_ERROR_INVALID_PARAMETER if the
+ *         chip holds an invalid time
+ */
+rtc_error_t pcf85063a_get_epoch(const struct device *dev, int64_t *epoch)
+{
+	uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+
+	if (epoch == NULL) {
+		LOG_ERR("epoch was null \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	rtc_error_t ret = pcf85063a_read_register(dev, time_block, sizeof(time_block),
+						  RTC_TIME_REGISTER_ADDRESS);
+	if (ret != RTC_SUCCESS) {
+		return ret;
+	}
+
+	return epoch_from_time_block(time_block, epoch);
+}
+
+/**
+ * @brief Reads the current time as milliseconds since 1970-01-01 00:00:00
+ *
+ * @param dev Pointer to the RTC device
+ * @param epoch_ms Pointer to store the milliseconds since the Unix epoch
+ * @return rtc_error_t Read status code
+ * @note The chip counts whole seconds, use pcf85063a_fast_now() for
+ *       millisecond resolution.
+ */
+rtc_error_t pcf85063a_get_epoch_ms(const struct device *dev, int64_t *epoch_ms)
+{
+	int64_t epoch;
+
+	if (epoch_ms == NULL) {
+		LOG_ERR("epoch_ms was null \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	rtc_error_t ret = pcf85063a_get_epoch(dev, &epoch);
+	if (ret == RTC_SUCCESS) {
+		*epoch_ms = epoch * MSEC_PER_SEC;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Sets the time from seconds since 1970-01-01 00:00:00
+ *
+ * @param dev Pointer to the RTC device
+ * @param epoch Seconds since the Unix epoch, between RTC_EPOCH_2000 and RTC_EPOCH_MAX
+ * @return rtc_error_t Write status code
+ */
+rtc_error_t pcf85063a_set_epoch(const struct device *dev, int64_t epoch)
+{
+	uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+
+	rtc_error_t ret = rtc_epoch_to_time_block(epoch, time_block);
+	if (ret != RTC_SUCCESS) {
+		LOG_ERR("Epoch %lld is outside the RTC range \n", epoch);
+		return ret;
+	}
+
+	return pcf85063a_write_register(dev, time_block, sizeof(time_block),
+					RTC_TIME_REGISTER_ADDRESS);
+}
+
+/**
+ * @brief Programs the Offset register to correct the crystal frequency
+ *
+ * @param dev Pointer to the RTC device
+ * @param correction_ppb Correction in parts per billion, positive to speed the clock up.
+ *        It is rounded to the nearest step of normal or fast mode, and clamped to the
+ *        register range of RTC_OFFSET_MIN_PPB to RTC_OFFSET_MAX_PPB, about +-275 ppm.
+ * @return rtc_error_t Write status code
+ * @note The Offset register returns to 0 on power-on or a software reset written to
+ *       Control_1. pcf85063a_initialize() does neither and keeps the correction.
+ */
+rtc_error_t pcf85063a_set_offset(const struct device *dev, int32_t correction_ppb)
+{
+	const uint8_t offset = rtc_offset_from_ppb(correction_ppb);
+
+	LOG_DBG("Offset 0x%02x for %d ppb \n", offset, correction_ppb);
+	return pcf85063a_write_register(dev, &offset, sizeof(offset), RTC_OFFSET_ADDRESS);
+}
+
+/**
+ * @brief Reads back the correction in the Offset register
+ *
+ * @param dev Pointer to the RTC device
+ * @param correction_ppb Pointer to store the correction in parts per billion
+ * @return rtc_error_t Read status code
+ */
+rtc_error_t pcf85063a_get_offset(const struct device *dev, int32_t *correction_ppb)
+{
+	uint8_t offset;
+
+	if (correction_ppb == NULL) {
+		LOG_ERR("correction_ppb was null \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	rtc_error_t ret = pcf85063a_read_register(dev, &offset, sizeof(offset), RTC_OFFSET_ADDRESS);
+	if (ret == RTC_SUCCESS) {
+		*correction_ppb = rtc_offset_to_ppb(offset);
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Reads the time block and anchors it to the CPU cycle counter
+ *
+ * @param dev Pointer to the RTC device
+ * @return rtc_error_t Read status code, RTC_ERROR_INVALID_PARAMETER if the
+ *         oscillator stopped or the chip holds an invalid time. The previous
+ *         anchor is kept on any error.
+ */
+static rtc_error_t fast_now_resync(const struct device *dev)
+{
+	struct pcf85063a_data *data = dev->data;
+	uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+	rtc_error_t ret = pcf85063a_read_register(dev, time_block, RTC_TIME_REGISTER_SIZE,
+						  RTC_TIME_REGISTER_ADDRESS);
+	const uint64_t cycles = k_cycle_get_64();
+
+	if (ret != RTC_SUCCESS) {
+		LOG_ERR("Error %d: failed to read time for fast now anchor \n", ret);
+		return ret;
+	}
+	if ((time_block[SECONDS_INDEX] & RTC_OSCILLATOR_STOPPED) ||
+	    !rtc_time_block_is_valid(time_block)) {
+		LOG_ERR("No valid time for fast now anchor \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&data->fast_now_lock);
+	data->fast_now_anchor.epoch_ms = rtc_time_block_to_epoch(time_block) * MSEC_PER_SEC;
+	data->fast_now_anchor.cycles = cycles;
+	data->fast_now_anchor.valid = true;
+	k_spin_unlock(&data->fast_now_lock, key);
+
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Returns the current wall time without going to the bus on every call
+ *
+ * The time block is read once and extrapolated from the CPU cycle counter until
+ * the resync interval runs out or the worst-case clock divergence reaches
+ * RTC_FAST_NOW_MAX_DRIFT_MS.
+ *
+ * @param dev Pointer to the RTC device
+ * @param epoch_ms Pointer to store the milliseconds since 1970-01-01 00:00:00
+ * @return rtc_error_t Status of the resync, if one was needed
+ * @note The RTC counts whole seconds, so the anchor carries up to one second of
+ *       phase error against the chip.
+ */
+rtc_error_t pcf85063a_fast_now(const struct device *dev, int64_t *epoch_ms)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	if (epoch_ms == NULL) {
+		LOG_ERR("epoch_ms was null \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&data->fast_now_lock);
+	bool valid = data->fast_now_anchor.valid;
+	int64_t base_ms = data->fast_now_anchor.epoch_ms;
+	uint64_t base_cycles = data->fast_now_anchor.cycles;
+	k_spin_unlock(&data->fast_now_lock, key);
+
+	uint64_t elapsed_ms = k_cyc_to_ms_floor64(k_cycle_get_64() - base_cycles);
+
+	if (!valid || elapsed_ms >= FAST_NOW_SYNC_INTERVAL_MS) {
+		rtc_error_t ret = fast_now_resync(dev);
+		if (ret != RTC_SUCCESS) {
+			return ret;
+		}
+
+		key = k_spin_lock(&data->fast_now_lock);
+		base_ms = data->fast_now_anchor.epoch_ms;
+		base_cycles = data->fast_now_anchor.cycles;
+		k_spin_unlock(&data->fast_now_lock, key);
+		elapsed_ms = k_cyc_to_ms_floor64(k_cycle_get_64() - base_cycles);
+	}
+
+	*epoch_ms = base_ms + elapsed_ms;
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Forces the next pcf85063a_fast_now() call to re-read the time block
+ *
+ * @param dev Pointer to the RTC device
+ * @note Called automatically whenever the driver writes the time block.
+ */
+void pcf85063a_fast_now_invalidate(const struct device *dev)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	k_spinlock_key_t key = k_spin_lock(&data->fast_now_lock);
+	data->fast_now_anchor.valid = false;
+	k_spin_unlock(&data->fast_now_lock, key);
+}
+
+/**
+ * @brief Returns the kernel uptime plus the time the kernel lost in deep sleeps
+ *
+ * @param dev Pointer to the RTC device
+ * @return int64_t Milliseconds since boot as counted by the RTC across deep sleeps
+ * @note Safe to call from ISRs, it never touches the bus.
+ */
+int64_t pcf85063a_uptime_ms(const struct device *dev)
+{
+#ifdef CONFIG_PCF85063A_DEEP_SLEEP
+	struct pcf85063a_data *data = dev->data;
+
+	k_spinlock_key_t key = k_spin_lock(&data->fast_now_lock);
+	const int64_t uptime_ms = k_uptime_get() + data->sleep.correction_ms;
+	k_spin_unlock(&data->fast_now_lock, key);
+
+	return uptime_ms;
+#else
+	ARG_UNUSED(dev);
+	return k_uptime_get();
+#endif
+}
+
+#ifdef CONFIG_PCF85063A_DEEP_SLEEP
+/**
+ * @brief Wakes the thread waiting in a deep sleep
+ *
+ * @param data Per-instance runtime state
+ */
+static void deep_sleep_woken(struct pcf85063a_data *data)
+{
+	data->sleep.woke_uptime = k_uptime_get();
+	k_sem_give(&data->sleep.wake);
+}
+
+/**
+ * @brief Hands an alarm flag to a waiting deep sleep
+ *
+ * @param data Per-instance runtime state
+ * @return bool True if the alarm was the wake-up of pcf85063a_deep_sleep_until()
+ */
+static bool deep_sleep_wake(struct pcf85063a_data *data)
+{
+	if (!data->sleep.active || !data->sleep.borrowed) {
+		return false;
+	}
+
+	deep_sleep_woken(data);
+	return true;
+}
+
+#ifdef CONFIG_RTC_ALARM
+/**
+ * @brief Alarm multiplexer handler of a deep sleep scheduled as an entry
+ *
+ * @param entry Entry of the sleep, its user data is the sleeping instance
+ * @param now Seconds since the Unix epoch at dispatch
+ */
+static void deep_sleep_mux_handler(struct pcf85063a_alarm_entry *entry, int64_t now)
+{
+	ARG_UNUSED(now);
+
+	deep_sleep_woken(entry->user_data);
+}
+#endif
+
+/**
+ * @brief Tells whether a deep sleep goes through the alarm multiplexer
+ *
+ * @param dev Pointer to the RTC device
+ * @return bool True if a multiplexer owns the hardware alarm of the device
+ */
+static bool deep_sleep_on_mux(const struct device *dev)
+{
+#ifdef CONFIG_RTC_ALARM
+	return pcf85063a_alarm_mux_active(dev);
+#else
+	ARG_UNUSED(dev);
+	return false;
+#endif
+}
+
+/**
+ * @brief Notes the time a deep sleep starts at
+ *
+ * @param dev Pointer to the RTC device
+ * @param start_epoch Pointer to store the RTC seconds at the start of the sleep
+ * @param start_uptime Pointer to store the kernel uptime at the start of the sleep
+ * @return rtc_error_t Read status code
+ * @note The caller holds the device lock.
+ */
+static rtc_error_t deep_sleep_start_locked(const struct device *dev, int64_t *start_epoch,
+					   int64_t *start_uptime)
+{
+	uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+
+	rtc_error_t ret = read_register_locked(dev, time_block, RTC_TIME_REGISTER_SIZE,
+					       RTC_TIME_REGISTER_ADDRESS);
+	*start_uptime = k_uptime_get();
+	if (ret == RTC_SUCCESS) {
+		ret = epoch_from_time_block(time_block, start_epoch);
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Arms the alarm for wake_epoch and notes the time the sleep starts at
+ *
+ * @param dev Pointer to the RTC device
+ * @param alarm Alarm block matching wake_epoch
+ * @param saved_alarm Pointer to store the alarm block it replaces
+ * @param saved_control_2 Pointer to store Control_2 as it was
+ * @param start_epoch Pointer to store the RTC seconds at the start of the sleep
+ * @param start_uptime Pointer to store the kernel uptime at the start of the sleep
+ * @return rtc_error_t Status of the register accesses
+ * @note The caller holds the device lock.
+ */
+static rtc_error_t deep_sleep_arm_locked(const struct device *dev, const uint8_t *alarm,
+					 uint8_t *saved_alarm, uint8_t *saved_control_2,
+					 int64_t *start_epoch, int64_t *start_uptime)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	rtc_error_t ret = read_register_locked(dev, saved_alarm, RTC_ALARM_REGISTER_SIZE,
+					       RTC_ALARM_REGISTER_ADDRESS);
+	if (ret == RTC_SUCCESS) {
+		ret = read_register_locked(dev, saved_control_2, 1, RTC_CONTROL_2_ADDRESS);
+	}
+	if (ret != RTC_SUCCESS) {
+		return ret;
+	}
+
+	k_sem_reset(&data->sleep.wake);
+	data->sleep.active = true;
+	data->sleep.borrowed = true;
+	ret = write_alarm(dev, alarm, true);
+	if (ret == RTC_SUCCESS) {
+		ret = deep_sleep_start_locked(dev, start_epoch, start_uptime);
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Waits for the wake-up and corrects the uptime for kernel time lost meanwhile
+ *
+ * @param dev Pointer to the RTC device
+ * @param wake_epoch Seconds since the Unix epoch the wake-up is due at
+ * @param start_epoch RTC seconds at the start of the sleep
+ * @param start_uptime Kernel uptime at the start of the sleep
+ * @return rtc_error_t Status of reading the time back if the wake-up never came
+ */
+static rtc_error_t deep_sleep_wait(const struct device *dev, int64_t wake_epoch,
+				   int64_t start_epoch, int64_t start_uptime)
+{
+	struct pcf85063a_data *data = dev->data;
+	const int64_t sleep_ms = (wake_epoch - start_epoch) * MSEC_PER_SEC;
+	const k_timeout_t timeout = K_MSEC(sleep_ms + RTC_DEEP_SLEEP_MARGIN_MS);
+	rtc_error_t ret = RTC_SUCCESS;
+	int64_t rtc_ms;
+	int64_t woke_uptime;
+
+	if (k_sem_take(&data->sleep.wake, timeout) == 0) {
+		// The alarm fired on the edge of wake_epoch, the start lies somewhere in
+		// start_epoch, so the estimate is good to half a second
+		rtc_ms = sleep_ms - MSEC_PER_SEC / 2;
+		woke_uptime = data->sleep.woke_uptime;
+	} else {
+		int64_t now_epoch = start_epoch;
+
+		LOG_WRN("No wake-up alarm %lld ms after the sleep started \n",
+			sleep_ms + RTC_DEEP_SLEEP_MARGIN_MS);
+		ret = pcf85063a_get_epoch(dev, &now_epoch);
+		woke_uptime = k_uptime_get();
+		// Both reads lie somewhere in their second, good to a second
+		rtc_ms = (now_epoch - start_epoch) * MSEC_PER_SEC;
+	}
+	const int64_t lost_ms = rtc_ms - (woke_uptime - start_uptime);
+
+	if (ret == RTC_SUCCESS && lost_ms >= RTC_DEEP_SLEEP_SLIP_MS) {
+		k_spinlock_key_t key = k_spin_lock(&data->fast_now_lock);
+		data->sleep.correction_ms += lost_ms;
+		k_spin_unlock(&data->fast_now_lock, key);
+		LOG_INF("Kernel time stood still for %lld ms of deep sleep \n", lost_ms);
+	}
+	// The CPU cycle counter may have stopped as well
+	pcf85063a_fast_now_invalidate(dev);
+
+	return ret;
+}
+
+/**
+ * @brief Waits for one wake-up alarm and puts the displaced alarm back
+ *
+ * With an alarm multiplexer on the RTC the wake-up is one of its entries and
+ * no alarm is displaced. The only kernel timeout of the wait is the sleep plus
+ * RTC_DEEP_SLEEP_MARGIN_MS, so with CONFIG_PM the idle policy can still pick
+ * the deepest state until INT fires. Kernel time lost while the system timer
+ * was stopped is measured against the RTC and added to pcf85063a_uptime_ms().
+ * If the alarm never arrives, the time is read back from the RTC once the
+ * wait times out.
+ *
+ * @param dev Pointer to the RTC device
+ * @param wake_epoch Seconds since the Unix epoch, at most RTC_DEEP_SLEEP_MAX_S ahead
+ * @return rtc_error_t Status of the register accesses
+ */
+static rtc_error_t deep_sleep_once(const struct device *dev, int64_t wake_epoch)
+{
+	struct pcf85063a_data *data = dev->data;
+	const bool on_mux = deep_sleep_on_mux(dev);
+	uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+	uint8_t saved_alarm[RTC_ALARM_REGISTER_SIZE];
+	uint8_t saved_control_2 = 0;
+	int64_t start_epoch = 0;
+	int64_t start_uptime = 0;
+#ifdef CONFIG_RTC_ALARM
+	struct pcf85063a_alarm_entry entry;
+
+	pcf85063a_alarm_entry_init(&entry, deep_sleep_mux_handler, data);
+#endif
+
+	rtc_error_t ret = rtc_epoch_to_time_block(wake_epoch, time_block);
+	if (ret != RTC_SUCCESS) {
+		LOG_ERR("Wake-up time %lld is outside the RTC range \n", wake_epoch);
+		return ret;
+	}
+
+	// The weekday follows from the date, it is left out of the match
+	const uint8_t alarm[RTC_ALARM_REGISTER_SIZE] = {
+		time_block[SECONDS_INDEX], time_block[MINUTES_INDEX], time_block[HOURS_INDEX],
+		time_block[DATE_INDEX], RTC_ALARM_FIELD_DISABLE,
+	};
+
+	ret = pm_claim(dev);
+	if (ret != RTC_SUCCESS) {
+		return ret;
+	}
+	lock_device(dev);
+
+	if (data->sleep.active) {
+		k_mutex_unlock(&data->lock);
+		pm_release(dev);
+		LOG_ERR("The RTC is already waking another deep sleep \n");
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+	if (on_mux) {
+		k_sem_reset(&data->sleep.wake);
+		data->sleep.active = true;
+		data->sleep.borrowed = false;
+		ret = deep_sleep_start_locked(dev, &start_epoch, &start_uptime);
+	} else {
+		ret = deep_sleep_arm_locked(dev, alarm, saved_alarm, &saved_control_2,
+					    &start_epoch, &start_uptime);
+	}
+	const bool armed = data->sleep.active;
+
+	k_mutex_unlock(&data->lock);
+	// The device may suspend now, INT stays connected while AIE is set
+	pm_release(dev);
+
+#ifdef CONFIG_RTC_ALARM
+	// The multiplexer reads the time and writes the alarm, so it runs unlocked
+	if (on_mux && ret == RTC_SUCCESS) {
+		ret = pcf85063a_alarm_mux_add(dev, &entry, wake_epoch, 0);
+	}
+#endif
+	if (ret == RTC_SUCCESS) {
+		ret = deep_sleep_wait(dev, wake_epoch, start_epoch, start_uptime);
+	}
+
+	if (armed && on_mux) {
+#ifdef CONFIG_RTC_ALARM
+		// Only still scheduled if the wait timed out
+		(void)pcf85063a_alarm_mux_cancel(&entry);
+#endif
+		k_mutex_lock(&data->lock, K_FOREVER);
+		data->sleep.active = false;
+		k_mutex_unlock(&data->lock);
+	} else if (armed) {
+		rtc_error_t restore = pm_claim(dev);
+		if (restore == RTC_SUCCESS) {
+			lock_device(dev);
+			data->sleep.active = false;
+			restore = write_alarm(dev, saved_alarm, (saved_control_2 & RTC_CTRL2_AIE) != 0);
+			k_mutex_unlock(&data->lock);
+			pm_release(dev);
+		} else {
+			data->sleep.active = false;
+		}
+		if (ret == RTC_SUCCESS) {
+			ret = restore;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Sleeps until a wall time, on the RTC alarm for long sleeps
+ *
+ * Sleeps of at least RTC_DEEP_SLEEP_MIN_MS wait for the RTC alarm, waking
+ * through the INT GPIO, with only a fallback kernel timeout that ends
+ * RTC_DEEP_SLEEP_MARGIN_MS after the wake-up. Shorter sleeps, and every sleep
+ * on an instance without int-gpios, use k_sleep(). Sleeps longer than
+ * RTC_DEEP_SLEEP_MAX_S are split into several alarms.
+ *
+ * @param dev Pointer to the RTC device
+ * @param wake_epoch Seconds since the Unix epoch to wake at
+ * @return rtc_error_t Status of the register accesses, RTC_ERROR_DEVICE_SETUP
+ *         if another thread is in deep sleep on the same RTC
+ * @note Once pcf85063a_alarm_mux_init() has run for the RTC, the wake-up is
+ *       scheduled as an entry of its alarm multiplexer. Otherwise the hardware
+ *       alarm is borrowed for the sleep and put back after it, and an alarm of
+ *       the RTC API that falls within the sleep is missed.
+ * @note Returns within a second after wake_epoch. A past wake_epoch returns at once.
+ */
+rtc_error_t pcf85063a_deep_sleep_until(const struct device *dev, int64_t wake_epoch)
+{
+	const struct pcf85063a_config *config = dev->config;
+	int64_t now;
+
+	rtc_error_t ret = pcf85063a_get_epoch(dev, &now);
+	while (ret == RTC_SUCCESS && now < wake_epoch) {
+		const int64_t remaining_ms = (wake_epoch - now) * MSEC_PER_SEC;
+
+		if (config->int_gpio.port == NULL || remaining_ms < RTC_DEEP_SLEEP_MIN_MS) {
+			k_sleep(K_MSEC(remaining_ms));
+			break;
+		}
+
+		ret = deep_sleep_once(dev, MIN(wake_epoch, now + RTC_DEEP_SLEEP_MAX_S));
+		if (ret == RTC_SUCCESS) {
+			ret = pcf85063a_get_epoch(dev, &now);
+		}
+	}
+
+	return ret;
+}
+#endif /* CONFIG_PCF85063A_DEEP_SLEEP */
+
+/**
+ * @brief Takes an async operation from the pool and fills in its I2C messages
+ *
+ * @param dev Pointer to the RTC device
+ * @param buffer Read destination, or payload to copy for a write
+ * @param size Number of registers to transfer
+ * @param start_address Starting register address
+ * @param read True for a read, false for a write
+ * @return struct rtc_async_op* The operation, or NULL if the queue is full
+ */
+static struct rtc_async_op *async_op_alloc(const struct device *dev, const uint8_t *buffer,
+					   const uint8_t size, const uint8_t start_address,
+					   const bool read)
+{
+	struct rtc_async_op *op;
+
+	if (k_mem_slab_alloc(&async_slab, (void **)&op, K_NO_WAIT) != 0) {
+		return NULL;
+	}
+
+	memset(op, 0, sizeof(*op));
+	op->dev = dev;
+	op->size = size;
+	op->read = read;
+	op->data[0] = start_address;
+	op->msgs[0].buf = op->data;
+
+	if (read) {
+		op->read_buffer = (uint8_t *)buffer;
+		op->msgs[0].len = 1;
+		op->msgs[0].flags = I2C_MSG_WRITE;
+		op->msgs[1].buf = op->read_buffer;
+		op->msgs[1].len = size;
+		op->msgs[1].flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP;
+	} else {
+		memcpy(&op->data[1], buffer, size);
+		op->msgs[0].len = size + 1;
+		op->msgs[0].flags = I2C_MSG_WRITE | I2C_MSG_STOP;
+	}
+
+	return op;
+}
+
+/**
+ * @brief Returns a chain of operations to the pool
+ *
+ * @param op First operation of the chain
+ */
+static void async_op_free_chain(struct rtc_async_op *op)
+{
+	while (op != NULL) {
+		struct rtc_async_op *next = op->next;
+		k_mem_slab_free(&async_slab, op);
+		op = next;
+	}
+}
+
+/**
+ * @brief Peeks at the operation at the head of the queue
+ *
+ * @param data Pointer to the instance data
+ * @return struct rtc_async_op* The operation in flight
+ */
+static struct rtc_async_op *async_head(struct pcf85063a_data *data)
+{
+	k_spinlock_key_t key = k_spin_lock(&data->async_lock);
+	sys_snode_t *node = sys_slist_peek_head(&data->async_pending);
+	k_spin_unlock(&data->async_lock, key);
+
+	return CONTAINER_OF(node, struct rtc_async_op, node);
+}
+
+/**
+ * @brief Notes the result of the transfer at the head of the queue
+ *
+ * Bus drivers may call this from an ISR, so everything else is left to
+ * async_done_handler().
+ *
+ * @param bus Pointer to the I2C bus device
+ * @param result Transfer status from the bus driver
+ * @param user_data The completed struct rtc_async_op
+ */
+static void async_transfer_done(const struct device *bus, int result, void *user_data)
+{
+	struct rtc_async_op *op = user_data;
+	struct pcf85063a_data *data = op->dev->data;
+
+	ARG_UNUSED(bus);
+
+	pcf85063a_stats_record(op->read ? PCF85063A_STATS_READ : PCF85063A_STATS_WRITE, op->size,
+			       result, k_cycle_get_32() - op->start_cycles);
+	op->result = result;
+	k_work_submit(&data->async_done_work);
+}
+
+/**
+ * @brief Merges the staged bits of a masked one-register write into the current value
+ *
+ * The shadow is preferred, it has every synchronous write since the value was
+ * read ahead. Control_2 flags are written as 1, which leaves them alone.
+ *
+ * @param dev Pointer to the RTC device
+ * @param op Write whose update_mask is set
+ * @note The caller holds the device lock.
+ */
+static void async_merge_locked(const struct device *dev, struct rtc_async_op *op)
+{
+	struct pcf85063a_data *data = dev->data;
+	const uint8_t reg = op->data[0];
+	uint8_t current = op->base;
+
+	if (data->shadow_valid & BIT(reg)) {
+		current = data->register_shadow[reg];
+	}
+	if (reg == RTC_CONTROL_2_ADDRESS) {
+		current |= TXN_CONTROL_2_FLAGS;
+	}
+	op->data[1] = (current & ~op->update_mask) | (op->data[1] & op->update_mask);
+}
+
+/**
+ * @brief Hands the operation at the head of the queue to the bus
+ *
+ * Runs on the system work queue. A fresh operation asks the circuit breaker
+ * first, a retry was let through already. The operation is marked as on the
+ * bus under the device lock, so synchronous callers wait until it settled.
+ *
+ * @param work Pointer to the work structure
+ */
+static void async_submit_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct pcf85063a_data *data = CONTAINER_OF(dwork, struct pcf85063a_data, async_submit_work);
+	const struct device *dev = data->dev;
+	const struct pcf85063a_config *config = dev->config;
+	struct rtc_async_op *op = async_head(data);
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	if (op->retry == 0) {
+		op->refused = !rtc_breaker_allow(&data->breaker, k_uptime_get());
+		op->deadline = k_uptime_get() + data->bus_policy.deadline_ms;
+		if (op->update_mask != 0) {
+			async_merge_locked(dev, op);
+		}
+	}
+	data->async_on_bus = !op->refused;
+	k_mutex_unlock(&data->lock);
+
+	if (op->refused) {
+		k_work_submit(&data->async_done_work);
+		return;
+	}
+
+	op->start_cycles = k_cycle_get_32();
+#ifdef CONFIG_I2C_CALLBACK
+	int ret = i2c_transfer_cb_dt(&config->i2c, op->msgs, op->read ? 2 : 1,
+				     async_transfer_done, op);
+	if (ret != -ENOSYS) {
+		if (ret != 0) {
+			async_transfer_done(config->i2c.bus, ret, op);
+		}
+		return;
+	}
+#endif
+	// The bus has no callback support, run the transfer here instead
+	async_transfer_done(config->i2c.bus,
+			    i2c_transfer_dt(&config->i2c, op->msgs, op->read ? 2 : 1), op);
+}
+
+/**
+ * @brief Retries, or records the result of, the operation at the head of the queue
+ *
+ * @param dev Pointer to the RTC device
+ * @param op The operation at the head of the queue
+ * @param status Pointer to store the status of the operation once it is done
+ * @return bool False while a retry is pending
+ */
+static bool async_settle(const struct device *dev, struct rtc_async_op *op, rtc_error_t *status)
+{
+	struct pcf85063a_data *data = dev->data;
+	const struct rtc_bus_policy *policy = &data->bus_policy;
+	int ret = op->result;
+
+	*status = RTC_SUCCESS;
+	if (op->refused) {
+		*status = RTC_ERROR_BUS_UNAVAILABLE;
+		return true;
+	}
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	data->async_on_bus = false;
+	k_condvar_broadcast(&data->async_idle);
+	if (ret != 0 && op->retry < policy->retries) {
+		const uint32_t backoff = rtc_retry_backoff_ms(policy, op->retry);
+
+		if (k_uptime_get() + backoff < op->deadline) {
+			op->retry++;
+			k_mutex_unlock(&data->lock);
+			k_work_schedule(&data->async_submit_work, K_MSEC(backoff));
+			return false;
+		}
+		ret = -ETIMEDOUT;
+	}
+
+	breaker_record_locked(dev, ret);
+	if (ret == -ETIMEDOUT) {
+		*status = RTC_ERROR_TIMEOUT;
+	} else if (ret != 0) {
+		*status = op->read ? RTC_ERROR_I2C_READ : RTC_ERROR_I2C_WRITE;
+	} else if (op->read) {
+		shadow_update(dev, op->read_buffer, op->size, op->data[0]);
+	} else {
+		register_written(dev, &op->data[1], op->size, op->data[0]);
+	}
+	k_mutex_unlock(&data->lock);
+
+	if (ret != 0) {
+		LOG_ERR("Error %d: async %s failed \n", ret, op->read ? "read" : "write");
+	}
+	return true;
+}
+
+/**
+ * @brief Completes the operation at the head of the queue and starts the next one
+ *
+ * Runs on the system work queue, so the shadow and the state derived from it
+ * are updated under the device lock like after a synchronous transfer, and
+ * callbacks run in thread context.
+ *
+ * @param work Pointer to the work structure
+ */
+static void async_done_handler(struct k_work *work)
+{
+	struct pcf85063a_data *data = CONTAINER_OF(work, struct pcf85063a_data, async_done_work);
+	const struct device *dev = data->dev;
+	struct rtc_async_op *op = async_head(data);
+	struct rtc_async_op *last = op;
+	rtc_error_t status;
+
+	if (!async_settle(dev, op, &status)) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&data->async_lock);
+	sys_slist_find_and_remove(&data->async_pending, &op->node);
+
+	if (status != RTC_SUCCESS) {
+		// Drop the rest of the request, its callback reports the failure
+		while (last->next != NULL) {
+			last = last->next;
+			sys_slist_find_and_remove(&data->async_pending, &last->node);
+		}
+	}
+
+	bool idle = sys_slist_is_empty(&data->async_pending);
+	data->async_busy = !idle;
+	k_spin_unlock(&data->async_lock, key);
+
+	if (status != RTC_SUCCESS || op->next == NULL) {
+		// The request is done, drop the PM reference async_enqueue() took for it
+		pm_release(dev);
+		if (last->callback != NULL) {
+			last->callback(status, last->user_data);
+		}
+	}
+
+	if (status != RTC_SUCCESS) {
+		async_op_free_chain(op);
+	} else {
+		k_mem_slab_free(&async_slab, op);
+	}
+
+	if (!idle) {
+		k_work_reschedule(&data->async_submit_work, K_NO_WAIT);
+	}
+}
+
+/**
+ * @brief Queues a chain of operations and kicks the bus if it is idle
+ *
+ * The device stays resumed until the last operation of the chain completes.
+ *
+ * @param first First operation of the chain
+ * @return rtc_error_t RTC_ERROR_DEVICE_SETUP if the device could not be resumed,
+ *         the chain is freed then
+ * @note Must be called from thread context, resuming the bus may block.
+ */
+static rtc_error_t async_enqueue(struct rtc_async_op *first)
+{
+	const struct device *dev = first->dev;
+	struct pcf85063a_data *data = dev->data;
+
+	if (pm_claim(dev) != RTC_SUCCESS) {
+		async_op_free_chain(first);
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&data->async_lock);
+	for (struct rtc_async_op *op = first; op != NULL; op = op->next) {
+		sys_slist_append(&data->async_pending, &op->node);
+	}
+	bool start = !data->async_busy;
+	data->async_busy = true;
+	k_spin_unlock(&data->async_lock, key);
+
+	if (start) {
+		k_work_reschedule(&data->async_submit_work, K_NO_WAIT);
+	}
+
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Queues a read of the specified registers into the provided buffer
+ *
+ * @param dev Pointer to the RTC device
+ * @param read_buffer Pointer to the buffer to store read data, must stay valid until completion
+ * @param size Number of bytes to read
+ * @param start_address Starting address to read from
+ * @param callback Called with the result once the read completes, may be NULL
+ * @param user_data Pointer passed to callback
+ * @return rtc_error_t RTC_SUCCESS if the read was queued
+ */
+rtc_error_t pcf85063a_read_register_async(const struct device *dev, uint8_t *read_buffer,
+					  const uint8_t size, const uint8_t start_address,
+					  rtc_async_callback_t callback, void *user_data)
+{
+	rtc_error_t status = check_register_range(read_buffer, size, start_address);
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+
+	struct rtc_async_op *op = async_op_alloc(dev, read_buffer, size, start_address, true);
+	if (op == NULL) {
+		LOG_ERR("Async queue is full \n");
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	op->callback = callback;
+	op->user_data = user_data;
+	return async_enqueue(op);
+}
+
+/**
+ * @brief Queues a write of the provided buffer to the specified registers
+ *
+ * @param dev Pointer to the RTC device
+ * @param write_buffer Pointer to the data to write, copied before returning
+ * @param size Number of bytes to write
+ * @param start_address Starting address to write to
+ * @param callback Called with the result once the write completes, may be NULL
+ * @param user_data Pointer passed to callback
+ * @return rtc_error_t RTC_SUCCESS if the write was queued
+ */
+rtc_error_t pcf85063a_write_register_async(const struct device *dev, const uint8_t *write_buffer,
+					   const uint8_t size, const uint8_t start_address,
+					   rtc_async_callback_t callback, void *user_data)
+{
+	rtc_error_t status = check_register_range(write_buffer, size, start_address);
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+
+	struct rtc_async_op *op = async_op_alloc(dev, write_buffer, size, start_address, false);
+	if (op == NULL) {
+		LOG_ERR("Async queue is full \n");
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	op->callback = callback;
+	op->user_data = user_data;
+	return async_enqueue(op);
+}
+
+/**
+ * @brief Validates a time array and queues the time write
+ *
+ * @param dev Pointer to the RTC device
+ * @param time_array Pointer to an array containing time in format:
+ *                   sec, min, hr, day(1-31), weekday, month, year
+ * @param callback Called with the result once the time is written, may be NULL
+ * @param user_data Pointer passed to callback
+ * @return rtc_error_t Status of validation and queueing
+ */
+rtc_error_t pcf85063a_initialize_async(const struct device *dev, const uint8_t *time_array,
+				       rtc_async_callback_t callback, void *user_data)
+{
+	uint8_t image[RTC_TIME_REGISTER_SIZE + 1];
+
+	rtc_error_t status = check_time(time_array);
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+
+	if (!device_is_ready(dev)) {
+		LOG_ERR("Error: RTC device is not ready\n");
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	init_image(time_array, image);
+	return pcf85063a_write_register_async(dev, image, sizeof(image), RTC_RAM_BYTE_ADDRESS,
+					      callback, user_data);
+}
+
+#ifdef CONFIG_PCF85063A_ALARM
+/**
+ * @brief Queues the alarm control and alarm time writes as one request
+ *
+ * Control_2 is read ahead, AIE is set and a stale AF cleared when the write
+ * goes to the bus, the other Control_2 bits are left as they are then.
+ *
+ * @param dev Pointer to the RTC device
+ * @param alarm_buffer Pointer to an array containing:
+ *                     Sec, min, hour, day, weekday
+ * @param size Size of the alarm_buffer
+ * @param callback Called with the result once both writes complete, may be NULL
+ * @param user_data Pointer passed to callback
+ * @return rtc_error_t RTC_SUCCESS if the alarm was queued
+ */
+rtc_error_t pcf85063a_set_alarm_async(const struct device *dev, const uint8_t *alarm_buffer,
+				      const size_t size, rtc_async_callback_t callback,
+				      void *user_data)
+{
+	rtc_error_t status = check_alarm(alarm_buffer, size);
+	if (status != RTC_SUCCESS) {
+		return status;
+	}
+
+	const uint8_t control_2 = RTC_CTRL2_AIE;
+	struct rtc_async_op *control_op = async_op_alloc(dev, &control_2, sizeof(control_2),
+							 RTC_CONTROL_2_ADDRESS, false);
+	struct rtc_async_op *read_op = NULL;
+	struct rtc_async_op *alarm_op =
+		async_op_alloc(dev, alarm_buffer, size, RTC_ALARM_REGISTER_ADDRESS, false);
+
+	if (control_op != NULL) {
+		read_op = async_op_alloc(dev, &control_op->base, sizeof(control_op->base),
+					 RTC_CONTROL_2_ADDRESS, true);
+	}
+	if (read_op == NULL || alarm_op == NULL) {
+		LOG_ERR("Async queue is full \n");
+		async_op_free_chain(control_op);
+		async_op_free_chain(alarm_op);
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	control_op->update_mask = RTC_CTRL2_AIE | RTC_CTRL2_AF;
+	read_op->next = control_op;
+	control_op->next = alarm_op;
+	alarm_op->callback = callback;
+	alarm_op->user_data = user_data;
+	return async_enqueue(read_op);
+}
+#endif /* CONFIG_PCF85063A_ALARM */
+
+/**
+ * @brief RTC API: writes a broken-down time to the time block
+ *
+ * @param dev Pointer to the RTC device
+ * @param timeptr Time to set, years 2000-2099
+ * @return int 0 on success, negative errno otherwise
+ */
+static int pcf85063a_api_set_time(const struct device *dev, const struct rtc_time *timeptr)
+{
+	if (timeptr == NULL || timeptr->tm_sec < 0 || timeptr->tm_sec > 59 ||
+	    timeptr->tm_min < 0 || timeptr->tm_min > 59 || timeptr->tm_hour < 0 ||
+	    timeptr->tm_hour > 23 || timeptr->tm_mday < 1 || timeptr->tm_mday > 31 ||
+	    timeptr->tm_wday < 0 || timeptr->tm_wday > 6 || timeptr->tm_mon < 0 ||
+	    timeptr->tm_mon > 11 || timeptr->tm_year < RTC_TM_YEAR_MIN ||
+	    timeptr->tm_year > RTC_TM_YEAR_MAX) {
+		return -EINVAL;
+	}
+
+	const uint8_t fields[RTC_TIME_REGISTER_SIZE] = {
+		[SECONDS_INDEX] = timeptr->tm_sec,
+		[MINUTES_INDEX] = timeptr->tm_min,
+		[HOURS_INDEX] = timeptr->tm_hour,
+		[DATE_INDEX] = timeptr->tm_mday,
+		[WEEKDAY_INDEX] = timeptr->tm_wday,
+		[MONTH_INDEX] = timeptr->tm_mon + 1,
+		[YEAR_INDEX] = timeptr->tm_year - RTC_TM_YEAR_MIN,
+	};
+	uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+	rtc_time_block_to_bcd(fields, time_block);
+
+	if (!VALIDATE(rtc_time_block_is_valid(time_block))) {
+		return -EINVAL;
+	}
+
+	const rtc_error_t status = pcf85063a_write_register(dev, time_block, sizeof(time_block),
+							    RTC_TIME_REGISTER_ADDRESS);
+	return status == RTC_SUCCESS ? 0 : bus_errno(status);
+}
+
+/**
+ * @brief RTC API: reads the time block as a broken-down time
+ *
+ * @param dev Pointer to the RTC device
+ * @param timeptr Pointer to store the current time
+ * @return int 0 on success, -ENODATA if the oscillator stopped since the time was set
+ */
+static int pcf85063a_api_get_time(const struct device *dev, struct rtc_time *timeptr)
+{
+	uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+
+	if (timeptr == NULL) {
+		return -EINVAL;
+	}
+
+	const rtc_error_t status = pcf85063a_read_register(dev, time_block, sizeof(time_block),
+							   RTC_TIME_REGISTER_ADDRESS);
+	if (status != RTC_SUCCESS) {
+		return bus_errno(status);
+	}
+
+	if (time_block[SECONDS_INDEX] & RTC_OSCILLATOR_STOPPED) {
+		return -ENODATA;
+	}
+
+	uint8_t fields[RTC_TIME_REGISTER_SIZE];
+	rtc_time_block_to_binary(time_block, fields);
+
+	memset(timeptr, 0, sizeof(*timeptr));
+	timeptr->tm_sec = fields[SECONDS_INDEX];
+	timeptr->tm_min = fields[MINUTES_INDEX];
+	timeptr->tm_hour = fields[HOURS_INDEX];
+	timeptr->tm_mday = fields[DATE_INDEX];
+	timeptr->tm_wday = fields[WEEKDAY_INDEX];
+	timeptr->tm_mon = fields[MONTH_INDEX] - 1;
+	timeptr->tm_year = fields[YEAR_INDEX] + RTC_TM_YEAR_MIN;
+	timeptr->tm_yday = -1;
+	timeptr->tm_isdst = -1;
+
+	return 0;
+}
+
+#if defined(CONFIG_RTC_ALARM) && defined(CONFIG_PCF85063A_ALARM)
+/**
+ * @brief RTC API: reports the alarm fields the chip can match on
+ *
+ * @param dev Pointer to the RTC device
+ * @param id Alarm index, the chip has a single alarm
+ * @param mask Pointer to store the supported RTC_ALARM_TIME_MASK_* fields
+ * @return int 0 on success, -EINVAL for an unknown alarm
+ */
+static int pcf85063a_api_alarm_get_supported_fields(const struct device *dev, uint16_t id,
+						    uint16_t *mask)
+{
+	if (id != 0 || mask == NULL) {
+		return -EINVAL;
+	}
+
+	*mask = PCF85063A_ALARM_FIELDS;
+	return 0;
+}
+
+/**
+ * @brief Checks the alarm fields selected by mask against the ranges of the chip
+ *
+ * @param mask RTC_ALARM_TIME_MASK_* fields to match
+ * @param timeptr Alarm time
+ * @return bool True if every selected field is in range
+ */
+static bool alarm_fields_valid(uint16_t mask, const struct rtc_time *timeptr)
+{
+	if ((mask & RTC_ALARM_TIME_MASK_SECOND) && (timeptr->tm_sec < 0 || timeptr->tm_sec > 59)) {
+		return false;
+	}
+	if ((mask & RTC_ALARM_TIME_MASK_MINUTE) && (timeptr->tm_min < 0 || timeptr->tm_min > 59)) {
+		return false;
+	}
+	if ((mask & RTC_ALARM_TIME_MASK_HOUR) && (timeptr->tm_hour < 0 || timeptr->tm_hour > 23)) {
+		return false;
+	}
+	if ((mask & RTC_ALARM_TIME_MASK_MONTHDAY) &&
+	    (timeptr->tm_mday < 1 || timeptr->tm_mday > 31)) {
+		return false;
+	}
+	if ((mask & RTC_ALARM_TIME_MASK_WEEKDAY) &&
+	    (timeptr->tm_wday < 0 || timeptr->tm_wday > 6)) {
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief RTC API: programs the alarm, fields outside mask are disabled
+ *
+ * @param dev Pointer to the RTC device
+ * @param id Alarm index, the chip has a single alarm
+ * @param mask RTC_ALARM_TIME_MASK_* fields to match, 0 disables the alarm
+ * @param timeptr Alarm time
+ * @return int 0 on success, negative errno otherwise
+ */
+static int pcf85063a_api_alarm_set_time(const struct device *dev, uint16_t id, uint16_t mask,
+					const struct rtc_time *timeptr)
+{
+	if (id != 0 || (mask & ~PCF85063A_ALARM_FIELDS) != 0 || (mask != 0 && timeptr == NULL)) {
+		return -EINVAL;
+	}
+	if (mask != 0 && !alarm_fields_valid(mask, timeptr)) {
+		return -EINVAL;
+	}
+
+	uint8_t alarm_buffer[RTC_ALARM_REGISTER_SIZE] = {
+		RTC_ALARM_FIELD_DISABLE, RTC_ALARM_FIELD_DISABLE, RTC_ALARM_FIELD_DISABLE,
+		RTC_ALARM_FIELD_DISABLE, RTC_ALARM_FIELD_DISABLE,
+	};
+
+	if (mask & RTC_ALARM_TIME_MASK_SECOND) {
+		alarm_buffer[SECONDS_INDEX] = convert_to_bcd(timeptr->tm_sec);
+	}
+	if (mask & RTC_ALARM_TIME_MASK_MINUTE) {
+		alarm_buffer[MINUTES_INDEX] = convert_to_bcd(timeptr->tm_min);
+	}
+	if (mask & RTC_ALARM_TIME_MASK_HOUR) {
+		alarm_buffer[HOURS_INDEX] = convert_to_bcd(timeptr->tm_hour);
+	}
+	if (mask & RTC_ALARM_TIME_MASK_MONTHDAY) {
+		alarm_buffer[DATE_INDEX] = convert_to_bcd(timeptr->tm_mday);
+	}
+	if (mask & RTC_ALARM_TIME_MASK_WEEKDAY) {
+		alarm_buffer[WEEKDAY_INDEX] = timeptr->tm_wday;
+	}
+
+	const rtc_error_t status = write_alarm(dev, alarm_buffer, mask != 0);
+	return status == RTC_SUCCESS ? 0 : bus_errno(status);
+}
+
+/**
+ * @brief RTC API: reads back the programmed alarm
+ *
+ * @param dev Pointer to the RTC device
+ * @param id Alarm index, the chip has a single alarm
+ * @param mask Pointer to store the enabled RTC_ALARM_TIME_MASK_* fields
+ * @param timeptr Pointer to store the alarm time
+ * @return int 0 on success, negative errno otherwise
+ */
+static int pcf85063a_api_alarm_get_time(const struct device *dev, uint16_t id, uint16_t *mask,
+					struct rtc_time *timeptr)
+{
+	uint8_t alarm_buffer[RTC_ALARM_REGISTER_SIZE];
+
+	if (id != 0 || mask == NULL || timeptr == NULL) {
+		return -EINVAL;
+	}
+
+	if (pcf85063a_read_register(dev, alarm_buffer, sizeof(alarm_buffer),
+				    RTC_ALARM_REGISTER_ADDRESS) != RTC_SUCCESS) {
+		return -EIO;
+	}
+
+	memset(timeptr, 0, sizeof(*timeptr));
+	*mask = 0;
+
+	if (!(alarm_buffer[SECONDS_INDEX] & RTC_ALARM_FIELD_DISABLE)) {
+		*mask |= RTC_ALARM_TIME_MASK_SECOND;
+		timeptr->tm_sec = bcd_to_decimal(alarm_buffer[SECONDS_INDEX]);
+	}
+	if (!(alarm_buffer[MINUTES_INDEX] & RTC_ALARM_FIELD_DISABLE)) {
+		*mask |= RTC_ALARM_TIME_MASK_MINUTE;
+		timeptr->tm_min = bcd_to_decimal(alarm_buffer[MINUTES_INDEX]);
+	}
+	if (!(alarm_buffer[HOURS_INDEX] & RTC_ALARM_FIELD_DISABLE)) {
+		*mask |= RTC_ALARM_TIME_MASK_HOUR;
+		timeptr->tm_hour = bcd_to_decimal(alarm_buffer[HOURS_INDEX] & RTC_HOURS_MASK);
+	}
+	if (!(alarm_buffer[DATE_INDEX] & RTC_ALARM_FIELD_DISABLE)) {
+		*mask |= RTC_ALARM_TIME_MASK_MONTHDAY;
+		timeptr->tm_mday = bcd_to_decimal(alarm_buffer[DATE_INDEX] & RTC_DATE_MASK);
+	}
+	if (!(alarm_buffer[WEEKDAY_INDEX] & RTC_ALARM_FIELD_DISABLE)) {
+		*mask |= RTC_ALARM_TIME_MASK_WEEKDAY;
+		timeptr->tm_wday = alarm_buffer[WEEKDAY_INDEX] & RTC_WEEKDAY_MASK;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief RTC API: reports and clears an alarm seen since the last call
+ *
+ * @param dev Pointer to the RTC device
+ * @param id Alarm index, the chip has a single alarm
+ * @return int 1 if the alarm fired, 0 if not, -EINVAL for an unknown alarm
+ */
+static int pcf85063a_api_alarm_is_pending(const struct device *dev, uint16_t id)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	if (id != 0) {
+		return -EINVAL;
+	}
+
+	int pending = data->alarm_pending ? 1 : 0;
+	data->alarm_pending = false;
+	return pending;
+}
+
+/**
+ * @brief RTC API: registers the function called from the alarm work item
+ *
+ * @param dev Pointer to the RTC device
+ * @param id Alarm index, the chip has a single alarm
+ * @param callback Function to call when the alarm fires, NULL to remove
+ * @param user_data Pointer passed to callback
+ * @return int 0 on success, -EINVAL for an unknown alarm
+ */
+static int pcf85063a_api_alarm_set_callback(const struct device *dev, uint16_t id,
+					    rtc_alarm_callback callback, void *user_data)
+{
+	struct pcf85063a_data *data = dev->data;
+
+	if (id != 0) {
+		return -EINVAL;
+	}
+
+	data->alarm_callback = callback;
+	data->alarm_user_data = user_data;
+	return 0;
+}
+#endif /* CONFIG_RTC_ALARM && CONFIG_PCF85063A_ALARM */
+
+#ifdef CONFIG_RTC_CALIBRATION
+/**
+ * @brief RTC API: programs the Offset register
+ *
+ * @param dev Pointer to the RTC device
+ * @param calibration Frequency correction in parts per billion
+ * @return int 0 on success, -EINVAL beyond the register range, -EIO on a bus error
+ */
+static int pcf85063a_api_set_calibration(const struct device *dev, int32_t calibration)
+{
+	// Either mode may be picked, the range is that of normal mode
+	if (calibration > RTC_OFFSET_MAX_PPB || calibration < RTC_OFFSET_MIN_PPB) {
+		return -EINVAL;
+	}
+
+	return pcf85063a_set_offset(dev, calibration) == RTC_SUCCESS ? 0 : -EIO;
+}
+
+/**
+ * @brief RTC API: reads back the Offset register
+ *
+ * @param dev Pointer to the RTC device
+ * @param calibration Pointer to store the correction in parts per billion
+ * @return int 0 on success, -EIO on a bus error
+ */
+static int pcf85063a_api_get_calibration(const struct device *dev, int32_t *calibration)
+{
+	return pcf85063a_get_offset(dev, calibration) == RTC_SUCCESS ? 0 : -EIO;
+}
+#endif /* CONFIG_RTC_CALIBRATION */
+
+static const struct rtc_driver_api pcf85063a_driver_api = {
+	.set_time = pcf85063a_api_set_time,
+	.get_time = pcf85063a_api_get_time,
+#if defined(CONFIG_RTC_ALARM) && defined(CONFIG_PCF85063A_ALARM)
+	.alarm_get_supported_fields = pcf85063a_api_alarm_get_supported_fields,
+	.alarm_set_time = pcf85063a_api_alarm_set_time,
+	.alarm_get_time = pcf85063a_api_alarm_get_time,
+	.alarm_is_pending = pcf85063a_api_alarm_is_pending,
+	.alarm_set_callback = pcf85063a_api_alarm_set_callback,
+#endif
+#ifdef CONFIG_RTC_CALIBRATION
+	.set_calibration = pcf85063a_api_set_calibration,
+	.get_calibration = pcf85063a_api_get_calibration,
+#endif
+};
+
+#ifdef CONFIG_PCF85063A_INTERRUPT
+/**
+ * @brief Configures the INT pin as an edge interrupt input
+ *
+ * @param dev Pointer to the RTC device
+ * @return int 0 on success, negative errno otherwise
+ */
+static int int_gpio_connect(const struct device *dev)
+{
+	const struct pcf85063a_config *config = dev->config;
+
+	return pcf85063a_bus_irq_enable(&config->bus, true);
+}
+#endif
+
+#ifdef CONFIG_PM_DEVICE
+#ifdef CONFIG_PCF85063A_INTERRUPT
+/**
+ * @brief Disconnects the INT pin while no interrupt source of the chip is enabled
+ *
+ * @param dev Pointer to the RTC device
+ * @note The caller holds the device lock and has the control registers and
+ *       Timer_mode in the shadow, anything not in the shadow counts as enabled.
+ */
+static void int_gpio_park(const struct device *dev)
+{
+	const struct pcf85063a_config *config = dev->config;
+	struct pcf85063a_data *data = dev->data;
+	const uint32_t needed = BIT(RTC_CONTROL_2_ADDRESS) | BIT(RTC_TIMER_MODE_ADDRESS);
+
+	if (config->int_gpio.port == NULL || (data->shadow_valid & needed) != needed ||
+	    (data->register_shadow[RTC_CONTROL_2_ADDRESS] &
+	     (RTC_CTRL2_AIE | RTC_CTRL2_MI | RTC_CTRL2_HMI)) ||
+	    (data->register_shadow[RTC_TIMER_MODE_ADDRESS] & RTC_TIMER_MODE_TIE)) {
+		return;
+	}
+
+	pcf85063a_bus_irq_enable(&config->bus, false);
+	data->int_parked = true;
+}
+#else
+static inline void int_gpio_park(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+}
+
+static inline int int_gpio_connect(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+	return 0;
+}
+#endif /* CONFIG_PCF85063A_INTERRUPT */
+
+/**
+ * @brief Puts the chip into its low-power configuration before the bus is released
+ *
+ * CLKOUT is switched off and the quartz load capacitance is set from the
+ * devicetree. The CLKOUT setting is remembered for the resume. Nothing is
+ * written when the shadow shows both are already in place. Timer_mode is
+ * fetched as well if needed, so int_gpio_park() can tell whether INT is used.
+ *
+ * @param dev Pointer to the RTC device
+ * @return rtc_error_t Status of the register access
+ */
+static rtc_error_t pm_suspend_chip(const struct device *dev)
+{
+	const struct pcf85063a_config *config = dev->config;
+	struct pcf85063a_data *data = dev->data;
+	const uint8_t cap_sel = config->cap_12p5pf ? RTC_CTRL1_CAP_SEL : 0;
+	const uint32_t controls = BIT(RTC_CONTROL_1_ADDRESS) | BIT(RTC_CONTROL_2_ADDRESS);
+	struct pcf85063a_txn txn;
+
+	// Only software changes the bits used here, so the shadow can be trusted for them
+	if ((data->shadow_valid & controls) != controls) {
+		uint8_t control[2];
+
+		rtc_error_t ret = read_register_locked(dev, control, sizeof(control),
+						       RTC_CONTROL_1_ADDRESS);
+		if (ret != RTC_SUCCESS) {
+			return ret;
+		}
+	}
+	if (!(data->shadow_valid & BIT(RTC_TIMER_MODE_ADDRESS))) {
+		uint8_t timer_mode;
+
+		rtc_error_t ret = read_register_locked(dev, &timer_mode, sizeof(timer_mode),
+						       RTC_TIMER_MODE_ADDRESS);
+		if (ret != RTC_SUCCESS) {
+			return ret;
+		}
+	}
+
+	data->pm_clkout = data->register_shadow[RTC_CONTROL_2_ADDRESS] & RTC_CTRL2_COF_MASK;
+	if ((data->register_shadow[RTC_CONTROL_1_ADDRESS] & RTC_CTRL1_CAP_SEL) == cap_sel &&
+	    data->pm_clkout == RTC_CTRL2_COF_MASK) {
+		return RTC_SUCCESS;
+	}
+
+	pcf85063a_txn_init(&txn, dev);
+	pcf85063a_txn_update(&txn, RTC_CONTROL_1_ADDRESS, RTC_CTRL1_CAP_SEL, cap_sel);
+	pcf85063a_txn_update(&txn, RTC_CONTROL_2_ADDRESS, RTC_CTRL2_COF_MASK, RTC_CTRL2_COF_MASK);
+	return txn_commit_locked(&txn, NULL);
+}
+
+/**
+ * @brief Restores the CLKOUT setting found at the last suspend
+ *
+ * @param dev Pointer to the RTC device
+ * @return rtc_error_t Status of the register access
+ */
+static rtc_error_t pm_resume_chip(const struct device *dev)
+{
+	struct pcf85063a_data *data = dev->data;
+	struct pcf85063a_txn txn;
+
+	if (data->pm_clkout == RTC_CTRL2_COF_MASK) {
+		return RTC_SUCCESS;
+	}
+
+	pcf85063a_txn_init(&txn, dev);
+	pcf85063a_txn_update(&txn, RTC_CONTROL_2_ADDRESS, RTC_CTRL2_COF_MASK, data->pm_clkout);
+	return txn_commit_locked(&txn, NULL);
+}
+
+/**
+ * @brief Device PM hook, claims the I2C bus on resume and releases it on suspend
+ *
+ * @param dev Pointer to the RTC device
+ * @param action Requested PM action
+ * @return int 0 on success, negative errno otherwise
+ * @note Runs with a zero usage count, so no caller holds the device lock.
+ */
+static int pcf85063a_pm_action(const struct device *dev, enum pm_device_action action)
+{
+	const struct pcf85063a_config *config = dev->config;
+	struct pcf85063a_data *data = dev->data;
+	rtc_error_t status;
+	int ret;
+
+	switch (action) {
+	case PM_DEVICE_ACTION_RESUME:
+		ret = pm_device_runtime_get(config->i2c.bus);
+		if (ret < 0) {
+			LOG_ERR("Error %d: failed to resume the i2c bus \n", ret);
+			return ret;
+		}
+
+		if (data->int_parked) {
+			ret = int_gpio_connect(dev);
+			if (ret != 0) {
+				pm_device_runtime_put(config->i2c.bus);
+				return ret;
+			}
+			data->int_parked = false;
+		}
+
+		lock_device(dev);
+		status = pm_resume_chip(dev);
+		k_mutex_unlock(&data->lock);
+		if (status != RTC_SUCCESS) {
+			LOG_ERR("Error %d: failed to restore CLKOUT \n", status);
+		}
+		return 0;
+
+	case PM_DEVICE_ACTION_SUSPEND:
+		lock_device(dev);
+		status = pm_suspend_chip(dev);
+		if (status == RTC_SUCCESS) {
+			int_gpio_park(dev);
+		}
+		k_mutex_unlock(&data->lock);
+		if (status != RTC_SUCCESS) {
+			LOG_ERR("Error %d: failed to set the low-power bits \n", status);
+			return -EIO;
+		}
+
+		return pm_device_runtime_put(config->i2c.bus);
+
+	default:
+		return -ENOTSUP;
+	}
+}
+
+#endif /* CONFIG_PM_DEVICE */
+
+/**
+ * @brief Hands the device to runtime PM in the suspended state
+ *
+ * @param dev Pointer to the RTC device
+ * @return int 0 on success, negative errno otherwise
+ */
+static int pcf85063a_pm_init(const struct device *dev)
+{
+#ifdef CONFIG_PM_DEVICE_RUNTIME
+	pm_device_init_suspended(dev);
+	return pm_device_runtime_enable(dev);
+#else
+	ARG_UNUSED(dev);
+	return 0;
+#endif
+}
+
+/**
+ * @brief Completion of the register file read started by the init hook
+ *
+ * @param result Status of the read
+ * @param user_data Pointer to the RTC device
+ */
+static void boot_read_done(rtc_error_t result, void *user_data)
+{
+	const struct device *dev = user_data;
+	const struct pcf85063a_config *config = dev->config;
+	struct pcf85063a_data *data = dev->data;
+
+	data->boot.status = result;
+	k_sem_give(&data->boot.done);
+	pm_device_runtime_put_async(config->i2c.bus, K_NO_WAIT);
+}
+
+#ifdef CONFIG_PCF85063A_INTERRUPT
+/**
+ * @brief Sets up the optional INT GPIO and its interrupt work queue
+ *
+ * @param dev Pointer to the RTC device
+ * @return int 0 on success, negative errno otherwise
+ */
+static int int_gpio_init(const struct device *dev)
+{
+	const struct pcf85063a_config *config = dev->config;
+	struct pcf85063a_data *data = dev->data;
+
+	// Alarms can still be programmed and polled without an INT line
+	if (config->int_gpio.port == NULL) {
+		return 0;
+	}
+
+	if (!device_is_ready(config->int_gpio.port)) {
+		LOG_ERR("Error: interrupt GPIO device is not ready\n");
+		return -ENODEV;
+	}
+
+	int ret = int_gpio_connect(dev);
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (!int_workq_started) {
+		const struct k_work_queue_config int_workq_config = {.name = "pcf85063a_int"};
+
+		k_work_queue_start(&int_workq, int_workq_stack,
+				   K_THREAD_STACK_SIZEOF(int_workq_stack), RTC_INT_WORKQ_PRIORITY,
+				   &int_workq_config);
+		int_workq_started = true;
+	}
+
+	gpio_init_callback(&data->gpio_cb, int_gpio_callback, BIT(config->int_gpio.pin));
+	return gpio_add_callback(config->int_gpio.port, &data->gpio_cb);
+}
+#else
+static inline int int_gpio_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+	return 0;
+}
+#endif /* CONFIG_PCF85063A_INTERRUPT */
+
+/**
+ * @brief Device init hook, brings up the bus and the optional interrupt GPIO
+ *
+ * The whole register file is read asynchronously while the GPIO is set up.
+ * It primes the register shadow and lets pcf85063a_initialize_warm() decide
+ * without another bus access whether the time survived the reset.
+ *
+ * @param dev Pointer to the RTC device
+ * @return int 0 on success, negative errno otherwise
+ */
+static int pcf85063a_init(const struct device *dev)
+{
+	const struct pcf85063a_config *config = dev->config;
+	struct pcf85063a_data *data = dev->data;
+
+	data->dev = dev;
+	data->pm_clkout = RTC_CTRL2_COF_MASK;
+	data->bus_policy = (struct rtc_bus_policy){
+		.deadline_ms = CONFIG_PCF85063A_BUS_DEADLINE_MS,
+		.retries = CONFIG_PCF85063A_BUS_RETRIES,
+		.backoff_ms = CONFIG_PCF85063A_BUS_BACKOFF_MS,
+		.trip_failures = CONFIG_PCF85063A_BUS_TRIP_FAILURES,
+		.open_ms = CONFIG_PCF85063A_BUS_OPEN_MS,
+	};
+	k_mutex_init(&data->lock);
+	k_condvar_init(&data->async_idle);
+	k_mutex_init(&data->time_read.lock);
+	k_condvar_init(&data->time_read.done);
+	k_sem_init(&data->boot.done, 0, 1);
+	sys_slist_init(&data->async_pending);
+	k_work_init_delayable(&data->async_submit_work, async_submit_handler);
+	k_work_init(&data->async_done_work, async_done_handler);
+#ifdef CONFIG_PCF85063A_INTERRUPT
+	k_work_init_delayable(&data->int_work, int_work_handler);
+#endif
+#ifdef CONFIG_PCF85063A_DEEP_SLEEP
+	k_sem_init(&data->sleep.wake, 0, 1);
+#endif
+
+	if (!device_is_ready(config->i2c.bus)) {
+		LOG_ERR("Error: i2c device is not ready\n");
+		return -ENODEV;
+	}
+
+	// Runtime PM of the RTC is not enabled yet, so hold the bus directly for the boot read
+	int ret = pm_device_runtime_get(config->i2c.bus);
+	if (ret < 0) {
+		LOG_ERR("Error %d: failed to resume the i2c bus \n", ret);
+		return ret;
+	}
+
+	rtc_error_t status = pcf85063a_read_register_async(dev, data->boot.registers,
+							   RTC_REGISTER_SIZE, RTC_CONTROL_1_ADDRESS,
+							   boot_read_done, (void *)dev);
+	if (status != RTC_SUCCESS) {
+		pm_device_runtime_put(config->i2c.bus);
+	}
+
+	ret = int_gpio_init(dev);
+
+	if (status == RTC_SUCCESS &&
+	    k_sem_take(&data->boot.done, K_MSEC(RTC_BOOT_READ_TIMEOUT_MS)) == 0) {
+		data->boot.pending = data->boot.status == RTC_SUCCESS;
+	} else {
+		LOG_WRN("Boot read of the registers did not complete \n");
+	}
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	return pcf85063a_pm_init(dev);
+}
+
+#define PCF85063A_DEFINE(inst)                                                                     \
+	static const struct pcf85063a_config pcf85063a_config_##inst = {                          \
+		.i2c = I2C_DT_SPEC_INST_GET(inst),                                                 \
+		.int_gpio = GPIO_DT_SPEC_INST_GET_OR(inst, int_gpios, {0}),                        \
+		.bus = {.api = &i2c_bus_api, .ctx = &pcf85063a_config_##inst},                     \
+		.cap_12p5pf = DT_INST_PROP(inst, quartz_load_femtofarads) == 12500,                \
+	};                                                                                         \
+	static struct pcf85063a_data pcf85063a_data_##inst;                                        \
+	PM_DEVICE_DT_INST_DEFINE(inst, pcf85063a_pm_action);                                       \
+	DEVICE_DT_INST_DEFINE(inst, pcf85063a_init, PM_DEVICE_DT_INST_GET(inst),                   \
+			      &pcf85063a_data_##inst,                                              \
+			      &pcf85063a_config_##inst, POST_KERNEL, CONFIG_RTC_INIT_PRIORITY,     \
+			      &pcf85063a_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(PCF85063A_DEFINE)
+
+/*
+ * Single-instance API. These operate on the first enabled nxp,pcf85063a
+ * instance and are kept for applications written against the original driver.
+ */
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+#define DEFAULT_RTC DEVICE_DT_GET(DT_INST(0, DT_DRV_COMPAT))
+
+rtc_error_t initialize_RTC(const uint8_t *time_array)
+{
+	return pcf85063a_initialize(DEFAULT_RTC, time_array);
+}
+
+rtc_error_t initialize_RTC_warm(const uint8_t *time_array, bool *warm_boot)
+{
+	return pcf85063a_initialize_warm(DEFAULT_RTC, time_array, warm_boot);
+}
+
+rtc_error_t read_register(uint8_t *read_buffer, const uint8_t size, const uint8_t start_address)
+{
+	return pcf85063a_read_register(DEFAULT_RTC, read_buffer, size, start_address);
+}
+
+rtc_error_t write_register(const uint8_t *write_buffer, const uint8_t size,
+			   const uint8_t start_address)
+{
+	return pcf85063a_write_register(DEFAULT_RTC, write_buffer, size, start_address);
+}
+
+#ifdef CONFIG_PCF85063A_ALARM
+rtc_error_t set_alarm(const uint8_t *alarm_buffer, const size_t size)
+{
+	return pcf85063a_set_alarm(DEFAULT_RTC, alarm_buffer, size);
+}
+
+rtc_error_t rtc_set_recurring_alarm(rtc_alarm_repeat_t repeat, uint8_t day, uint8_t hour,
+				    uint8_t minute, uint8_t second)
+{
+	return pcf85063a_set_recurring_alarm(DEFAULT_RTC, repeat, day, hour, minute, second);
+}
+#endif /* CONFIG_PCF85063A_ALARM */
+
+void rtc_cache_invalidate(void)
+{
+	pcf85063a_cache_invalidate(DEFAULT_RTC);
+}
+
+rtc_error_t rtc_set_bus_policy(const struct rtc_bus_policy *policy)
+{
+	return pcf85063a_set_bus_policy(DEFAULT_RTC, policy);
+}
+
+rtc_error_t rtc_get_bus_health(struct rtc_breaker *breaker)
+{
+	return pcf85063a_get_bus_health(DEFAULT_RTC, breaker);
+}
+
+rtc_error_t rtc_fast_now(int64_t *epoch_ms)
+{
+	return pcf85063a_fast_now(DEFAULT_RTC, epoch_ms);
+}
+
+void rtc_fast_now_invalidate(void)
+{
+	pcf85063a_fast_now_invalidate(DEFAULT_RTC);
+}
+
+rtc_error_t rtc_get_epoch(int64_t *epoch)
+{
+	return pcf85063a_get_epoch(DEFAULT_RTC, epoch);
+}
+
+rtc_error_t rtc_get_epoch_ms(int64_t *epoch_ms)
+{
+	return pcf85063a_get_epoch_ms(DEFAULT_RTC, epoch_ms);
+}
+
+rtc_error_t rtc_set_epoch(int64_t epoch)
+{
+	return pcf85063a_set_epoch(DEFAULT_RTC, epoch);
+}
+
+rtc_error_t rtc_set_offset(int32_t correction_ppb)
+{
+	return pcf85063a_set_offset(DEFAULT_RTC, correction_ppb);
+}
+
+rtc_error_t rtc_get_offset(int32_t *correction_ppb)
+{
+	return pcf85063a_get_offset(DEFAULT_RTC, correction_ppb);
+}
+
+rtc_error_t rtc_timer_start(rtc_timer_clock_t clock, uint8_t reload, bool pulse,
+			    rtc_timer_handler_t handler, void *user_data)
+{
+	return pcf85063a_timer_start(DEFAULT_RTC, clock, reload, pulse, handler, user_data);
+}
+
+rtc_error_t rtc_timer_stop(void)
+{
+	return pcf85063a_timer_stop(DEFAULT_RTC);
+}
+
+#ifdef CONFIG_PCF85063A_DEEP_SLEEP
+rtc_error_t rtc_deep_sleep_until(int64_t wake_epoch)
+{
+	return pcf85063a_deep_sleep_until(DEFAULT_RTC, wake_epoch);
+}
+#endif
+
+int64_t rtc_uptime_ms(void)
+{
+	return pcf85063a_uptime_ms(DEFAULT_RTC);
+}
+
+#ifdef CONFIG_PCF85063A_INTERRUPT
+rtc_error_t rtc_get_int_latency(struct pcf85063a_int_latency *latency)
+{
+	return pcf85063a_get_int_latency(DEFAULT_RTC, latency);
+}
+
+void rtc_reset_int_latency(void)
+{
+	pcf85063a_reset_int_latency(DEFAULT_RTC);
+}
+#endif
+
+rtc_error_t initialize_RTC_async(const uint8_t *time_array, rtc_async_callback_t callback,
+				 void *user_data)
+{
+	return pcf85063a_initialize_async(DEFAULT_RTC, time_array, callback, user_data);
+}
+
+rtc_error_t read_register_async(uint8_t *read_buffer, const uint8_t size,
+				const uint8_t start_address, rtc_async_callback_t callback,
+				void *user_data)
+{
+	return pcf85063a_read_register_async(DEFAULT_RTC, read_buffer, size, start_address,
+					     callback, user_data);
+}
+
+rtc_error_t write_register_async(const uint8_t *write_buffer, const uint8_t size,
+				 const uint8_t start_address, rtc_async_callback_t callback,
+				 void *user_data)
+{
+	return pcf85063a_write_register_async(DEFAULT_RTC, write_buffer, size, start_address,
+					      callback, user_data);
+}
+
+#ifdef CONFIG_PCF85063A_ALARM
+rtc_error_t set_alarm_async(const uint8_t *alarm_buffer, const size_t size,
+			    rtc_async_callback_t callback, void *user_data)
+{
+	return pcf85063a_set_alarm_async(DEFAULT_RTC, alarm_buffer, size, callback, user_data);
+}
+#endif
+#endif /* DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT) */
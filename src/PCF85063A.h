@@ -1,54 +1,208 @@
 #ifndef PCF85063_H
 #define PCF85063_H
 
-#define SECONDS_INDEX 0
-#define MINUTES_INDEX 1
-#define HOURS_INDEX 2
-#define DATE_INDEX 3
-#define WEEKDAY_INDEX 4
-#define MONTH_INDEX 5
-#define YEAR_INDEX 6
-#define TIME_HOURS_INDEX 0
-#define TIME_MINUTES_INDEX 3
-#define TIME_SECONDS_INDEX 6
-#define DATE_MONTH_END 3
-#define DATE_DAY_START 4
-#define YEAR_DIGITS 2
-#define BCD_SHIFT 4
-#define CONFIG_PCF85063A_LOG_LEVEL 3
-
-#define RTC_ADDRESS 0x51
-#define RTC_REGISTER_SIZE 18
-#define RTC_ALARM_REGISTER_SIZE 5
-#define RTC_TIME_REGISTER_ADDRESS 0x04
-#define RTC_ALARM_REGISTER_ADDRESS 0x0B
-#define RTC_TIME_REGISTER_SIZE 7
-#define ENABLE_ALARM 0x80
-#define ALARM_CONTROL_REGISTER 1
-
-#define PCF85063A_INT_NODE DT_NODELABEL(pcf85063a_int1)
+#include <zephyr/device.h>
+#include "PCF85063A_core.h"
 
+// rtc_fast_now() resyncs after RTC_FAST_NOW_RESYNC_MS, or sooner if the worst-case
+// divergence of the CPU clock from the RTC (RTC_FAST_NOW_CLOCK_PPM) could exceed
+// RTC_FAST_NOW_MAX_DRIFT_MS.
+#define RTC_FAST_NOW_RESYNC_MS 60000
+#define RTC_FAST_NOW_MAX_DRIFT_MS 50
+#define RTC_FAST_NOW_CLOCK_PPM 100
+
+// Number of async register operations that can be queued at once
+#define RTC_ASYNC_QUEUE_DEPTH 8
+
+// INT edges are served on a dedicated work queue. Negative priorities are cooperative,
+// both values can be overridden from the build.
+#ifndef RTC_INT_WORKQ_PRIORITY
+#define RTC_INT_WORKQ_PRIORITY -2
+#endif
+#ifndef RTC_INT_WORKQ_STACK_SIZE
+#define RTC_INT_WORKQ_STACK_SIZE 1024
+#endif
+#define RTC_INT_LATENCY_BUCKETS 32
+
+// Written to RAM_byte together with the time. Finding it after a reset, with OS clear,
+// means the chip kept time and the warm-boot path leaves the time block alone.
+#define RTC_WARM_BOOT_SIGNATURE 0xC3
+// How long the device init hook waits for the register file read it starts at boot
+#define RTC_BOOT_READ_TIMEOUT_MS 100
+
+// pcf85063a_deep_sleep_until() sleeps shorter than RTC_DEEP_SLEEP_MIN_MS on the kernel
+// timer. The alarm matches day of month, hour, minute and second, so one alarm covers
+// at most RTC_DEEP_SLEEP_MAX_S. Kernel time lost in a deep sleep is only corrected
+// once it reaches RTC_DEEP_SLEEP_SLIP_MS, below that it is measurement noise. A wake-up
+// alarm missing RTC_DEEP_SLEEP_MARGIN_MS after the sleep should have ended is given up on.
+#define RTC_DEEP_SLEEP_MIN_MS 10000
+#define RTC_DEEP_SLEEP_MAX_S (28 * 24 * 3600)
+#define RTC_DEEP_SLEEP_SLIP_MS 1000
+#define RTC_DEEP_SLEEP_MARGIN_MS 2000
+
+/**
+ * @brief Completion callback for async RTC operations
+ *
+ * @param result Status of the operation
+ * @param user_data Pointer passed in when the operation was queued
+ * @note Runs on the system work queue.
+ */
+typedef void (*rtc_async_callback_t)(rtc_error_t result, void *user_data);
+
+// Countdown timer source clocks, the values of the Timer_mode TCF field
+typedef enum {
+    RTC_TIMER_CLOCK_4096HZ = 0,
+    RTC_TIMER_CLOCK_64HZ = 1,
+    RTC_TIMER_CLOCK_1HZ = 2,
+    RTC_TIMER_CLOCK_1_60HZ = 3,
+} rtc_timer_clock_t;
+
+// Repeat periods of pcf85063a_set_recurring_alarm(), each enables one more alarm field
 typedef enum {
-    RTC_SUCCESS = 0,
-    RTC_ERROR_DEVICE_SETUP = -1,
-    RTC_ERROR_I2C_WRITE = -2,
-    RTC_ERROR_I2C_READ = -3,
-    RTC_ERROR_INVALID_PARAMETER = -4,
-    RTC_ERROR_GPIO_CONFIG = -5,
-} rtc_error_t;
+    RTC_ALARM_EVERY_MINUTE = 0, // At second
+    RTC_ALARM_HOURLY = 1,       // At minute:second
+    RTC_ALARM_DAILY = 2,        // At hour:minute:second
+    RTC_ALARM_WEEKLY = 3,       // On weekday day (0-6, Sunday is 0) at hour:minute:second
+    RTC_ALARM_MONTHLY = 4,      // On date day (1-31) at hour:minute:second
+} rtc_alarm_repeat_t;
+
+/**
+ * @brief Called from the interrupt work item on every countdown timer expiry
+ *
+ * @param dev Pointer to the RTC device
+ * @param user_data Pointer passed in when the timer was started
+ */
+typedef void (*rtc_timer_handler_t)(const struct device *dev, void *user_data);
+
+// Register writes and read-modify-writes staged for one combined I2C transaction
+struct pcf85063a_txn {
+    const struct device *dev;
+    uint8_t image[RTC_REGISTER_SIZE];
+    uint8_t update_mask[RTC_REGISTER_SIZE]; // Bits staged by pcf85063a_txn_update()
+    uint32_t dirty;                         // Registers to write
+    uint32_t known;                         // Registers whose whole value is staged
+};
+
+// INT edge to handler completion latencies, bucket i counts 2^i to 2^(i + 1) - 1 cycles
+struct pcf85063a_int_latency {
+    uint32_t buckets[RTC_INT_LATENCY_BUCKETS];
+    uint32_t count;
+    uint32_t max_cycles;
+};
 
 extern volatile bool alarm_trigger;
 
-uint8_t * get_civic_time();
-uint8_t extract_time_component(const char *time_str, int index);
-uint8_t find_month(const char *month_str);
-uint8_t find_month(const char *month_str);
+#ifdef CONFIG_PCF85063A_BUILD_TIME
+const uint8_t *get_civic_time(void);
+#endif
+
+// Per-instance API, dev is an nxp,pcf85063a device from the devicetree
+rtc_error_t pcf85063a_initialize(const struct device *dev, const uint8_t *time_array);
+rtc_error_t pcf85063a_initialize_warm(const struct device *dev, const uint8_t *time_array,
+				      bool *warm_boot);
+rtc_error_t pcf85063a_read_register(const struct device *dev, uint8_t *read_buffer,
+				    const uint8_t size, const uint8_t start_address);
+rtc_error_t pcf85063a_write_register(const struct device *dev, const uint8_t *write_buffer,
+				     const uint8_t size, const uint8_t start_address);
+#ifdef CONFIG_PCF85063A_ALARM
+rtc_error_t pcf85063a_set_alarm(const struct device *dev, const uint8_t *alarm_buffer,
+				const size_t size);
+rtc_error_t pcf85063a_set_recurring_alarm(const struct device *dev, rtc_alarm_repeat_t repeat,
+					  uint8_t day, uint8_t hour, uint8_t minute, uint8_t second);
+#endif
+void pcf85063a_txn_init(struct pcf85063a_txn *txn, const struct device *dev);
+rtc_error_t pcf85063a_txn_write(struct pcf85063a_txn *txn, const uint8_t *write_buffer,
+				const uint8_t size, const uint8_t start_address);
+rtc_error_t pcf85063a_txn_update(struct pcf85063a_txn *txn, const uint8_t address,
+				 const uint8_t mask, const uint8_t value);
+rtc_error_t pcf85063a_txn_commit(struct pcf85063a_txn *txn);
+void pcf85063a_cache_invalidate(const struct device *dev);
+rtc_error_t pcf85063a_set_bus_policy(const struct device *dev, const struct rtc_bus_policy *policy);
+rtc_error_t pcf85063a_get_bus_health(const struct device *dev, struct rtc_breaker *breaker);
+rtc_error_t pcf85063a_fast_now(const struct device *dev, int64_t *epoch_ms);
+void pcf85063a_fast_now_invalidate(const struct device *dev);
+rtc_error_t pcf85063a_get_epoch(const struct device *dev, int64_t *epoch);
+rtc_error_t pcf85063a_get_epoch_ms(const struct device *dev, int64_t *epoch_ms);
+rtc_error_t pcf85063a_set_epoch(const struct device *dev, int64_t epoch);
+rtc_error_t pcf85063a_set_offset(const struct device *dev, int32_t correction_ppb);
+rtc_error_t pcf85063a_get_offset(const struct device *dev, int32_t *correction_ppb);
+rtc_error_t pcf85063a_timer_start(const struct device *dev, rtc_timer_clock_t clock, uint8_t reload,
+				  bool pulse, rtc_timer_handler_t handler, void *user_data);
+rtc_error_t pcf85063a_timer_stop(const struct device *dev);
+#ifdef CONFIG_PCF85063A_DEEP_SLEEP
+rtc_error_t pcf85063a_deep_sleep_until(const struct device *dev, int64_t wake_epoch);
+#endif
+int64_t pcf85063a_uptime_ms(const struct device *dev);
+#ifdef CONFIG_PCF85063A_INTERRUPT
+rtc_error_t pcf85063a_get_int_latency(const struct device *dev,
+				      struct pcf85063a_int_latency *latency);
+void pcf85063a_reset_int_latency(const struct device *dev);
+#endif
+rtc_error_t pcf85063a_initialize_async(const struct device *dev, const uint8_t *time_array,
+				       rtc_async_callback_t callback, void *user_data);
+rtc_error_t pcf85063a_read_register_async(const struct device *dev, uint8_t *read_buffer,
+					  const uint8_t size, const uint8_t start_address,
+					  rtc_async_callback_t callback, void *user_data);
+rtc_error_t pcf85063a_write_register_async(const struct device *dev, const uint8_t *write_buffer,
+					   const uint8_t size, const uint8_t start_address,
+					   rtc_async_callback_t callback, void *user_data);
+#ifdef CONFIG_PCF85063A_ALARM
+rtc_error_t pcf85063a_set_alarm_async(const struct device *dev, const uint8_t *alarm_buffer,
+				      const size_t size, rtc_async_callback_t callback,
+				      void *user_data);
+#endif
 
+// Single-instance API, operates on the first enabled nxp,pcf85063a instance
 rtc_error_t initialize_RTC(const uint8_t *time_array);
+rtc_error_t initialize_RTC_warm(const uint8_t *time_array, bool *warm_boot);
 rtc_error_t read_register(uint8_t *read_buffer, const uint8_t size, const uint8_t start_address);
 rtc_error_t write_register(const uint8_t *write_buffer, const uint8_t size, const uint8_t start_address);
 
+#ifdef CONFIG_PCF85063A_ALARM
 rtc_error_t set_alarm(const uint8_t *alarm_buffer, const size_t size);
+rtc_error_t rtc_set_recurring_alarm(rtc_alarm_repeat_t repeat, uint8_t day, uint8_t hour,
+				    uint8_t minute, uint8_t second);
+#endif
+
+void rtc_cache_invalidate(void);
+rtc_error_t rtc_set_bus_policy(const struct rtc_bus_policy *policy);
+rtc_error_t rtc_get_bus_health(struct rtc_breaker *breaker);
+
+rtc_error_t rtc_fast_now(int64_t *epoch_ms);
+void rtc_fast_now_invalidate(void);
+
+rtc_error_t rtc_get_epoch(int64_t *epoch);
+rtc_error_t rtc_get_epoch_ms(int64_t *epoch_ms);
+rtc_error_t rtc_set_epoch(int64_t epoch);
+rtc_error_t rtc_set_offset(int32_t correction_ppb);
+rtc_error_t rtc_get_offset(int32_t *correction_ppb);
+
+rtc_error_t rtc_timer_start(rtc_timer_clock_t clock, uint8_t reload, bool pulse,
+			    rtc_timer_handler_t handler, void *user_data);
+rtc_error_t rtc_timer_stop(void);
+
+#ifdef CONFIG_PCF85063A_DEEP_SLEEP
+rtc_error_t rtc_deep_sleep_until(int64_t wake_epoch);
+#endif
+int64_t rtc_uptime_ms(void);
+
+#ifdef CONFIG_PCF85063A_INTERRUPT
+rtc_error_t rtc_get_int_latency(struct pcf85063a_int_latency *latency);
+void rtc_reset_int_latency(void);
+#endif
+
+rtc_error_t initialize_RTC_async(const uint8_t *time_array, rtc_async_callback_t callback,
+				 void *user_data);
+rtc_error_t read_register_async(uint8_t *read_buffer, const uint8_t size,
+				const uint8_t start_address, rtc_async_callback_t callback,
+				void *user_data);
+rtc_error_t write_register_async(const uint8_t *write_buffer, const uint8_t size,
+				 const uint8_t start_address, rtc_async_callback_t callback,
+				 void *user_data);
+#ifdef CONFIG_PCF85063A_ALARM
+rtc_error_t set_alarm_async(const uint8_t *alarm_buffer, const size_t size,
+			    rtc_async_callback_t callback, void *user_data);
+#endif
 
 
 
@@ -0,0 +1,465 @@
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/rtc.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include "PCF85063A.h"
+#include "PCF85063A_alarm_mux.h"
+
+LOG_MODULE_REGISTER(pcf85063a_alarm_mux, CONFIG_PCF85063A_LOG_LEVEL);
+
+/*
+ * Software alarms multiplexed onto the chip's single alarm. Entries sit in a
+ * binary min-heap keyed on deadline + slack, the hardware alarm always holds
+ * the key of the heap root and is only rewritten when the root changes. Every
+ * wake-up dispatches all entries whose deadline has passed, so entries with
+ * overlapping [deadline, deadline + slack] windows share one interrupt. Every
+ * RTC instance gets its own multiplexer.
+ */
+
+// Value of programmed_expiry while the hardware alarm is disabled
+#define NO_EXPIRY INT64_MAX
+
+#define ALARM_MUX_FIELDS                                                                           \
+	(RTC_ALARM_TIME_MASK_SECOND | RTC_ALARM_TIME_MASK_MINUTE | RTC_ALARM_TIME_MASK_HOUR |     \
+	 RTC_ALARM_TIME_MASK_MONTHDAY)
+
+// One multiplexer per enabled RTC instance
+#define ALARM_MUX_COUNT MAX(DT_NUM_INST_STATUS_OKAY(nxp_pcf85063a), 1)
+
+struct pcf85063a_alarm_mux {
+	const struct device *dev; // Set by pcf85063a_alarm_mux_init(), guarded by both locks
+	struct k_mutex lock;      // Initialized once at boot, a slot may be reused
+	struct pcf85063a_alarm_entry *heap[RTC_ALARM_MUX_MAX_ENTRIES];
+	size_t count;
+	int64_t programmed_expiry;
+};
+
+static struct pcf85063a_alarm_mux muxes[ALARM_MUX_COUNT];
+// Taken before a mux lock, so a looked up mux cannot be released before it is locked
+static K_MUTEX_DEFINE(muxes_lock);
+
+/**
+ * @brief Finds the multiplexer of an RTC
+ *
+ * @param dev Pointer to the RTC device
+ * @return struct pcf85063a_alarm_mux* The multiplexer, or NULL if none was set up
+ * @note The caller holds muxes_lock.
+ */
+static struct pcf85063a_alarm_mux *mux_of(const struct device *dev)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(muxes); i++) {
+		if (muxes[i].dev == dev) {
+			return &muxes[i];
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Initializes the lock of every multiplexer at boot
+ */
+static int pcf85063a_alarm_mux_sys_init(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(muxes); i++) {
+		k_mutex_init(&muxes[i].lock);
+	}
+
+	return 0;
+}
+
+SYS_INIT(pcf85063a_alarm_mux_sys_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+/**
+ * @brief Places an entry at a heap position and records the position in it
+ */
+static inline void heap_set(struct pcf85063a_alarm_mux *mux, size_t index,
+			    struct pcf85063a_alarm_entry *entry)
+{
+	mux->heap[index] = entry;
+	entry->index = index;
+}
+
+/**
+ * @brief Moves the entry at index towards the root until its parent expires earlier
+ */
+static void heap_sift_up(struct pcf85063a_alarm_mux *mux, size_t index)
+{
+	struct pcf85063a_alarm_entry *entry = mux->heap[index];
+
+	while (index > 0) {
+		size_t parent = (index - 1) / 2;
+		if (mux->heap[parent]->expiry <= entry->expiry) {
+			break;
+		}
+		heap_set(mux, index, mux->heap[parent]);
+		index = parent;
+	}
+	heap_set(mux, index, entry);
+}
+
+/**
+ * @brief Moves the entry at index towards the leaves until its children expire later
+ */
+static void heap_sift_down(struct pcf85063a_alarm_mux *mux, size_t index)
+{
+	struct pcf85063a_alarm_entry *entry = mux->heap[index];
+
+	for (;;) {
+		size_t child = 2 * index + 1;
+		if (child >= mux->count) {
+			break;
+		}
+		if (child + 1 < mux->count &&
+		    mux->heap[child + 1]->expiry < mux->heap[child]->expiry) {
+			child++;
+		}
+		if (entry->expiry <= mux->heap[child]->expiry) {
+			break;
+		}
+		heap_set(mux, index, mux->heap[child]);
+		index = child;
+	}
+	heap_set(mux, index, entry);
+}
+
+/**
+ * @brief Takes an entry out of the heap
+ */
+static void heap_remove(struct pcf85063a_alarm_mux *mux, struct pcf85063a_alarm_entry *entry)
+{
+	size_t index = entry->index;
+	struct pcf85063a_alarm_entry *last = mux->heap[--mux->count];
+
+	entry->index = -1;
+	entry->mux = NULL;
+	if (last == entry) {
+		return;
+	}
+
+	heap_set(mux, index, last);
+	heap_sift_up(mux, index);
+	heap_sift_down(mux, last->index);
+}
+
+/**
+ * @brief Writes the hardware alarm for an expiry, or disables it for NO_EXPIRY
+ *
+ * Day, hour, minute and second are matched, so an expiry more than a month
+ * away wakes up early on the same day of an earlier month. The wake-up finds
+ * nothing due and programs the alarm again.
+ *
+ * @param mux Multiplexer of the RTC
+ * @param expiry Seconds since the Unix epoch
+ * @return rtc_error_t Write status code
+ */
+static rtc_error_t program_alarm(struct pcf85063a_alarm_mux *mux, int64_t expiry)
+{
+	uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+	uint8_t fields[RTC_TIME_REGISTER_SIZE];
+	struct rtc_time alarm_time = {0};
+	uint16_t mask = 0;
+
+	if (expiry != NO_EXPIRY) {
+		rtc_error_t ret = rtc_epoch_to_time_block(expiry, time_block);
+		if (ret != RTC_SUCCESS) {
+			return ret;
+		}
+		rtc_time_block_to_binary(time_block, fields);
+		alarm_time.tm_sec = fields[SECONDS_INDEX];
+		alarm_time.tm_min = fields[MINUTES_INDEX];
+		alarm_time.tm_hour = fields[HOURS_INDEX];
+		alarm_time.tm_mday = fields[DATE_INDEX];
+		mask = ALARM_MUX_FIELDS;
+	}
+
+	if (rtc_alarm_set_time(mux->dev, 0, mask, mask != 0 ? &alarm_time : NULL) != 0) {
+		LOG_ERR("Failed to program the hardware alarm \n");
+		return RTC_ERROR_I2C_WRITE;
+	}
+
+	mux->programmed_expiry = expiry;
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Dispatches due entries and keeps the hardware alarm on the heap root
+ *
+ * Without fired, nothing touches the bus unless the root changed since the
+ * alarm was last programmed. Handlers run without the lock held, so they can
+ * add and cancel entries.
+ *
+ * @param mux Multiplexer of the RTC
+ * @param fired True when called for a hardware alarm interrupt
+ */
+static void mux_service(struct pcf85063a_alarm_mux *mux, bool fired)
+{
+	struct pcf85063a_alarm_entry *expired[RTC_ALARM_MUX_MAX_ENTRIES];
+	int64_t now;
+	size_t count;
+
+	do {
+		k_mutex_lock(&mux->lock, K_FOREVER);
+
+		// Released by pcf85063a_alarm_mux_deinit() since the alarm fired
+		if (mux->dev == NULL) {
+			k_mutex_unlock(&mux->lock);
+			return;
+		}
+
+		int64_t root_expiry = mux->count > 0 ? mux->heap[0]->expiry : NO_EXPIRY;
+		if (!fired && root_expiry == mux->programmed_expiry) {
+			k_mutex_unlock(&mux->lock);
+			return;
+		}
+
+		if (pcf85063a_get_epoch(mux->dev, &now) != RTC_SUCCESS) {
+			k_mutex_unlock(&mux->lock);
+			LOG_ERR("Failed to read the time for the alarm mux \n");
+			return;
+		}
+
+		count = 0;
+		for (size_t i = 0; i < mux->count; i++) {
+			if (mux->heap[i]->deadline <= now) {
+				expired[count++] = mux->heap[i];
+			}
+		}
+		for (size_t i = 0; i < count; i++) {
+			heap_remove(mux, expired[i]);
+		}
+
+		root_expiry = mux->count > 0 ? mux->heap[0]->expiry : NO_EXPIRY;
+		fired = false;
+		if (root_expiry != mux->programmed_expiry &&
+		    program_alarm(mux, root_expiry) == RTC_SUCCESS && root_expiry != NO_EXPIRY) {
+			// An expiry that went by while the alarm was written never matches
+			fired = pcf85063a_get_epoch(mux->dev, &now) == RTC_SUCCESS &&
+				now >= root_expiry;
+		}
+
+		k_mutex_unlock(&mux->lock);
+
+		for (size_t i = 0; i < count; i++) {
+			expired[i]->handler(expired[i], now);
+		}
+	} while (count > 0 || fired);
+}
+
+/**
+ * @brief Hardware alarm callback, runs on the driver's alarm work item
+ */
+static void mux_alarm_callback(const struct device *dev, uint16_t id, void *user_data)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(id);
+
+	mux_service(user_data, true);
+}
+
+/**
+ * @brief Takes over the hardware alarm of an RTC for the multiplexer
+ *
+ * @param dev Pointer to the RTC device
+ * @return rtc_error_t RTC_ERROR_DEVICE_SETUP if the device is not ready, or
+ *         RTC_ERROR_INVALID_PARAMETER if the device already has a multiplexer
+ * @note The alarm callback of the device belongs to the multiplexer afterwards,
+ *       set_alarm() and rtc_alarm_set_time() must no longer be used on it.
+ *       pcf85063a_deep_sleep_until() schedules its wake-up through it.
+ */
+rtc_error_t pcf85063a_alarm_mux_init(const struct device *dev)
+{
+	struct pcf85063a_alarm_mux *mux;
+
+	if (dev == NULL || !device_is_ready(dev)) {
+		LOG_ERR("RTC device not ready for the alarm mux \n");
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	k_mutex_lock(&muxes_lock, K_FOREVER);
+	if (mux_of(dev) != NULL) {
+		k_mutex_unlock(&muxes_lock);
+		LOG_ERR("%s already has an alarm mux \n", dev->name);
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+	mux = mux_of(NULL);
+	if (mux == NULL) {
+		k_mutex_unlock(&muxes_lock);
+		LOG_ERR("No alarm mux left for %s \n", dev->name);
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+	k_mutex_lock(&mux->lock, K_FOREVER);
+	mux->count = 0;
+	mux->programmed_expiry = 0;
+	mux->dev = dev;
+	k_mutex_unlock(&mux->lock);
+	k_mutex_unlock(&muxes_lock);
+
+	if (rtc_alarm_set_callback(dev, 0, mux_alarm_callback, mux) != 0) {
+		LOG_ERR("Failed to register the alarm mux callback \n");
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	k_mutex_lock(&mux->lock, K_FOREVER);
+	const rtc_error_t ret = program_alarm(mux, NO_EXPIRY);
+	k_mutex_unlock(&mux->lock);
+	return ret;
+}
+
+/**
+ * @brief Gives the hardware alarm of an RTC back, disabled and without callback
+ *
+ * @param dev Pointer to the RTC device
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER if the device has no multiplexer,
+ *         otherwise the status of disabling the alarm
+ * @note Entries still scheduled are dropped without running their handlers. A
+ *       deep sleep waiting on one wakes when its fallback timeout ends.
+ */
+rtc_error_t pcf85063a_alarm_mux_deinit(const struct device *dev)
+{
+	k_mutex_lock(&muxes_lock, K_FOREVER);
+	struct pcf85063a_alarm_mux *mux = dev != NULL ? mux_of(dev) : NULL;
+
+	if (mux == NULL) {
+		k_mutex_unlock(&muxes_lock);
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	(void)rtc_alarm_set_callback(dev, 0, NULL, NULL);
+
+	k_mutex_lock(&mux->lock, K_FOREVER);
+	while (mux->count > 0) {
+		heap_remove(mux, mux->heap[0]);
+	}
+	const rtc_error_t ret = program_alarm(mux, NO_EXPIRY);
+	mux->dev = NULL;
+	k_mutex_unlock(&mux->lock);
+
+	k_mutex_unlock(&muxes_lock);
+	return ret;
+}
+
+/**
+ * @brief Tells whether the hardware alarm of an RTC belongs to a multiplexer
+ *
+ * @param dev Pointer to the RTC device
+ * @return bool True once pcf85063a_alarm_mux_init() has run for the device
+ */
+bool pcf85063a_alarm_mux_active(const struct device *dev)
+{
+	if (dev == NULL) {
+		return false;
+	}
+
+	k_mutex_lock(&muxes_lock, K_FOREVER);
+	const bool active = mux_of(dev) != NULL;
+	k_mutex_unlock(&muxes_lock);
+	return active;
+}
+
+/**
+ * @brief Prepares an entry for scheduling
+ *
+ * @param entry Entry owned by the caller, it must stay valid while scheduled
+ * @param handler Function called once the deadline has passed
+ * @param user_data Pointer stored in the entry for the handler
+ */
+void pcf85063a_alarm_entry_init(struct pcf85063a_alarm_entry *entry,
+				pcf85063a_alarm_handler_t handler, void *user_data)
+{
+	entry->handler = handler;
+	entry->user_data = user_data;
+	entry->mux = NULL;
+	entry->index = -1;
+}
+
+/**
+ * @brief Schedules an entry, moving it if it is already scheduled
+ *
+ * The handler runs at the first wake-up at or after deadline and no later than
+ * deadline + slack. A deadline that has already passed is dispatched right away.
+ *
+ * @param dev Pointer to the RTC device whose multiplexer schedules the entry
+ * @param entry Entry set up with pcf85063a_alarm_entry_init()
+ * @param deadline Seconds since the Unix epoch
+ * @param slack Seconds the entry may be delayed to share a wake-up with others
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER if all entries are in use, the
+ *         deadline is outside the RTC range or the entry is scheduled on another RTC
+ */
+rtc_error_t pcf85063a_alarm_mux_add(const struct device *dev, struct pcf85063a_alarm_entry *entry,
+				    int64_t deadline, uint32_t slack)
+{
+	struct pcf85063a_alarm_mux *mux;
+
+	if (dev == NULL || entry == NULL || entry->handler == NULL) {
+		LOG_ERR("Alarm entry not initialized \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	if (deadline < RTC_EPOCH_2000 || deadline > RTC_EPOCH_MAX) {
+		LOG_ERR("Alarm deadline %lld is outside the RTC range \n", deadline);
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	k_mutex_lock(&muxes_lock, K_FOREVER);
+	mux = mux_of(dev);
+	if (mux == NULL) {
+		k_mutex_unlock(&muxes_lock);
+		LOG_ERR("%s has no alarm mux \n", dev->name);
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+	k_mutex_lock(&mux->lock, K_FOREVER);
+	k_mutex_unlock(&muxes_lock);
+
+	if (entry->index >= 0 && entry->mux != mux) {
+		k_mutex_unlock(&mux->lock);
+		LOG_ERR("Alarm entry is scheduled on another RTC \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	} else if (entry->index >= 0) {
+		heap_remove(mux, entry);
+	} else if (mux->count == RTC_ALARM_MUX_MAX_ENTRIES) {
+		k_mutex_unlock(&mux->lock);
+		LOG_ERR("All %d alarm entries are in use \n", RTC_ALARM_MUX_MAX_ENTRIES);
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	entry->deadline = deadline;
+	entry->expiry = MIN(deadline + slack, RTC_EPOCH_MAX);
+	entry->mux = mux;
+	heap_set(mux, mux->count++, entry);
+	heap_sift_up(mux, entry->index);
+
+	k_mutex_unlock(&mux->lock);
+
+	mux_service(mux, false);
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Removes a scheduled entry, the hardware alarm moves to the next one
+ *
+ * @param entry Entry to remove
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER if the entry is not scheduled
+ */
+rtc_error_t pcf85063a_alarm_mux_cancel(struct pcf85063a_alarm_entry *entry)
+{
+	struct pcf85063a_alarm_mux *mux = entry != NULL ? entry->mux : NULL;
+
+	if (mux == NULL) {
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	k_mutex_lock(&mux->lock, K_FOREVER);
+
+	// The entry may have been dispatched since it was looked at
+	if (entry->index < 0 || entry->mux != mux) {
+		k_mutex_unlock(&mux->lock);
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+	heap_remove(mux, entry);
+
+	k_mutex_unlock(&mux->lock);
+
+	mux_service(mux, false);
+	return RTC_SUCCESS;
+}
@@ -0,0 +1,39 @@
+#ifndef PCF85063A_ALARM_MUX_H
+#define PCF85063A_ALARM_MUX_H
+
+#include <zephyr/device.h>
+#include "PCF85063A.h"
+
+// Number of entries that can be scheduled at once
+#define RTC_ALARM_MUX_MAX_ENTRIES 16
+
+struct pcf85063a_alarm_entry;
+struct pcf85063a_alarm_mux;
+
+/**
+ * @brief Called from the alarm work item once the entry's deadline has passed
+ *
+ * @param entry The expired entry, it may be scheduled again from here
+ * @param now Seconds since the Unix epoch at dispatch
+ */
+typedef void (*pcf85063a_alarm_handler_t)(struct pcf85063a_alarm_entry *entry, int64_t now);
+
+struct pcf85063a_alarm_entry {
+	pcf85063a_alarm_handler_t handler;
+	void *user_data;
+	int64_t deadline;                // Seconds since the Unix epoch
+	int64_t expiry;                  // Deadline plus the allowed slack, the heap key
+	struct pcf85063a_alarm_mux *mux; // Multiplexer it is scheduled on, NULL while not
+	int16_t index;                   // Position in the heap, -1 while not scheduled
+};
+
+rtc_error_t pcf85063a_alarm_mux_init(const struct device *dev);
+rtc_error_t pcf85063a_alarm_mux_deinit(const struct device *dev);
+bool pcf85063a_alarm_mux_active(const struct device *dev);
+void pcf85063a_alarm_entry_init(struct pcf85063a_alarm_entry *entry,
+				pcf85063a_alarm_handler_t handler, void *user_data);
+rtc_error_t pcf85063a_alarm_mux_add(const struct device *dev, struct pcf85063a_alarm_entry *entry,
+				    int64_t deadline, uint32_t slack);
+rtc_error_t pcf85063a_alarm_mux_cancel(struct pcf85063a_alarm_entry *entry);
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef PCF85063A_BUS_H
+#define PCF85063A_BUS_H
+
+/*
+ * Bus and interrupt line seen by the register-level code. The driver backs it
+ * with the devicetree I2C bus and INT GPIO, host builds with a mock chip.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "PCF85063A_core.h"
+
+// One run of consecutive registers written in a single burst
+struct pcf85063a_burst {
+    uint8_t start_address;
+    uint8_t size;
+    const uint8_t *data;
+};
+
+struct pcf85063a_bus;
+
+struct pcf85063a_bus_api {
+    // Reads size registers from start_address on, returns 0 or a negative errno
+    int (*read)(const struct pcf85063a_bus *bus, uint8_t start_address, uint8_t *buffer,
+                uint8_t size);
+    // Sends the bursts as one transfer with a repeated start between them
+    int (*write)(const struct pcf85063a_bus *bus, const struct pcf85063a_burst *bursts,
+                 size_t count);
+    // Connects the INT line as an edge interrupt, or disconnects it
+    int (*irq_enable)(const struct pcf85063a_bus *bus, bool enable);
+};
+
+struct pcf85063a_bus {
+    const struct pcf85063a_bus_api *api;
+    const void *ctx; // Implementation state, e.g. the driver's devicetree config
+};
+
+static inline int pcf85063a_bus_read(const struct pcf85063a_bus *bus, uint8_t start_address,
+				     uint8_t *buffer, uint8_t size)
+{
+	return bus->api->read(bus, start_address, buffer, size);
+}
+
+static inline int pcf85063a_bus_write(const struct pcf85063a_bus *bus, uint8_t start_address,
+				      const uint8_t *buffer, uint8_t size)
+{
+	const struct pcf85063a_burst burst = {start_address, size, buffer};
+
+	return bus->api->write(bus, &burst, 1);
+}
+
+static inline int pcf85063a_bus_write_bursts(const struct pcf85063a_bus *bus,
+					     const struct pcf85063a_burst *bursts, size_t count)
+{
+	return bus->api->write(bus, bursts, count);
+}
+
+static inline int pcf85063a_bus_irq_enable(const struct pcf85063a_bus *bus, bool enable)
+{
+	return bus->api->irq_enable(bus, enable);
+}
+
+rtc_error_t pcf85063a_bus_get_time(const struct pcf85063a_bus *bus, uint8_t *fields);
+
+#endif
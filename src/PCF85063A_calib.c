@@ -0,0 +1,359 @@
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+#include "PCF85063A.h"
+#include "PCF85063A_calib.h"
+
+#ifdef CONFIG_SETTINGS
+#include <zephyr/settings/settings.h>
+#endif
+
+LOG_MODULE_REGISTER(pcf85063a_calib, CONFIG_PCF85063A_LOG_LEVEL);
+
+/*
+ * Crystal drift estimation for the Offset register. A work item timestamps RTC
+ * second edges against a reference clock, either the CPU cycle counter or the
+ * last time passed to pcf85063a_calib_reference() carried forward on the cycle
+ * counter. Once the samples since the last register update span
+ * RTC_CALIB_MIN_SPAN_S, the drift between the first and the latest one is
+ * folded into the correction. The register is only rewritten when that moves
+ * it by a step, then the measurement starts over at the new rate.
+ */
+
+static void calib_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(calib_work, calib_work_handler);
+
+static struct {
+	const struct device *dev;
+	struct k_spinlock lock;
+	rtc_calib_ref_t reference;
+
+	// Reference time waiting for the next second edge, and the cycle count it was taken at
+	bool reference_pending;
+	int64_t reference_us;
+	uint64_t reference_cycles;
+
+	// First sample at the current Offset value
+	bool anchor_valid;
+	int64_t anchor_seconds;
+	int64_t anchor_reference_us;
+
+	struct pcf85063a_calib_status status;
+
+	// Edge search state, only touched by the work handler
+	bool polling;
+	int64_t poll_seconds;
+	uint64_t poll_cycles;
+} calib;
+
+/**
+ * @brief Converts a signed cycle count difference to microseconds
+ *
+ * @param from Earlier cycle count
+ * @param to Later cycle count, may also be the earlier one
+ * @return int64_t Microseconds from from to to
+ */
+static int64_t cycles_between_us(uint64_t from, uint64_t to)
+{
+	return to >= from ? (int64_t)k_cyc_to_us_floor64(to - from)
+			  : -(int64_t)k_cyc_to_us_floor64(from - to);
+}
+
+#ifdef CONFIG_SETTINGS
+/**
+ * @brief Settings loader for the persisted correction
+ */
+static int calib_settings_load(const char *key, size_t len, settings_read_cb read_cb,
+			       void *cb_arg, void *param)
+{
+	int32_t *correction_ppb = param;
+
+	ARG_UNUSED(key);
+	if (len != sizeof(*correction_ppb)) {
+		return -EINVAL;
+	}
+
+	return read_cb(cb_arg, correction_ppb, sizeof(*correction_ppb)) == sizeof(*correction_ppb)
+		       ? 0
+		       : -EIO;
+}
+#endif
+
+/**
+ * @brief Stores the correction so that it survives a power loss, which clears the register
+ *
+ * @param correction_ppb Estimated correction in parts per billion
+ */
+static void calib_persist(int32_t correction_ppb)
+{
+#ifdef CONFIG_SETTINGS
+	const int ret = settings_save_one(RTC_CALIB_SETTINGS_KEY, &correction_ppb,
+					  sizeof(correction_ppb));
+	if (ret != 0) {
+		LOG_ERR("Error %d: failed to persist the offset correction \n", ret);
+	}
+#else
+	ARG_UNUSED(correction_ppb);
+#endif
+}
+
+/**
+ * @brief Folds one second edge into the drift estimate, updating the Offset register if needed
+ *
+ * @param dev Pointer to the RTC device
+ * @param seconds Seconds since the Unix epoch that started at the edge
+ * @param edge_cycles CPU cycle count at the edge
+ */
+static void calib_apply_edge(const struct device *dev, int64_t seconds, uint64_t edge_cycles)
+{
+	k_spinlock_key_t key = k_spin_lock(&calib.lock);
+	int64_t reference_us;
+
+	if (calib.reference == RTC_CALIB_REF_CYCLES) {
+		reference_us = (int64_t)k_cyc_to_us_floor64(edge_cycles);
+	} else if (calib.reference_pending) {
+		reference_us = calib.reference_us + cycles_between_us(calib.reference_cycles,
+								      edge_cycles);
+		calib.reference_pending = false;
+	} else {
+		k_spin_unlock(&calib.lock, key);
+		return;
+	}
+
+	const int64_t rtc_elapsed_us = (seconds - calib.anchor_seconds) * USEC_PER_SEC;
+	const int64_t reference_elapsed_us = reference_us - calib.anchor_reference_us;
+	const int32_t drift_ppb = rtc_drift_ppb(rtc_elapsed_us, reference_elapsed_us);
+	const int32_t drift_limit_ppb = RTC_CALIB_MAX_DRIFT_PPM * 1000;
+
+	if (!calib.anchor_valid || reference_elapsed_us <= 0 || drift_ppb > drift_limit_ppb ||
+	    drift_ppb < -drift_limit_ppb) {
+		if (calib.anchor_valid) {
+			LOG_WRN("RTC moved %lld us against the reference, restarting \n",
+				rtc_elapsed_us - reference_elapsed_us);
+		}
+		calib.anchor_valid = true;
+		calib.anchor_seconds = seconds;
+		calib.anchor_reference_us = reference_us;
+		calib.status.drift_ppb = 0;
+		calib.status.span_s = 0;
+		k_spin_unlock(&calib.lock, key);
+		return;
+	}
+
+	calib.status.drift_ppb = drift_ppb;
+	calib.status.span_s = (uint32_t)(seconds - calib.anchor_seconds);
+
+	// The measured drift is what the current correction left over
+	const int32_t correction_ppb = calib.status.correction_ppb - drift_ppb;
+	const bool update = calib.status.span_s >= RTC_CALIB_MIN_SPAN_S &&
+			    rtc_offset_from_ppb(correction_ppb) !=
+				    rtc_offset_from_ppb(calib.status.correction_ppb);
+
+	k_spin_unlock(&calib.lock, key);
+
+	LOG_DBG("Drift %d ppb over %lld s \n", drift_ppb, seconds - calib.anchor_seconds);
+	if (!update) {
+		return;
+	}
+
+	rtc_error_t ret = pcf85063a_set_offset(dev, correction_ppb);
+	if (ret != RTC_SUCCESS) {
+		LOG_ERR("Error %d: failed to write the offset register \n", ret);
+		return;
+	}
+	calib_persist(correction_ppb);
+	LOG_INF("Offset correction %d ppb for %d ppb drift \n", correction_ppb, drift_ppb);
+
+	// Measure the rate the new correction gives from here on
+	key = k_spin_lock(&calib.lock);
+	calib.status.correction_ppb = rtc_offset_to_ppb(rtc_offset_from_ppb(correction_ppb));
+	calib.status.drift_ppb = 0;
+	calib.status.span_s = 0;
+	calib.status.updates++;
+	calib.anchor_seconds = seconds;
+	calib.anchor_reference_us = reference_us;
+	k_spin_unlock(&calib.lock, key);
+}
+
+/**
+ * @brief Polls the seconds register until it changes and timestamps the edge
+ *
+ * Each read is stamped with the cycle count halfway through the transfer, and
+ * the edge is placed halfway between the last read of the old second and the
+ * first read of the new one.
+ */
+static void calib_work_handler(struct k_work *work)
+{
+	uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+
+	k_spinlock_key_t key = k_spin_lock(&calib.lock);
+	const struct device *dev = calib.dev;
+	const bool periodic = calib.reference == RTC_CALIB_REF_CYCLES;
+	k_spin_unlock(&calib.lock, key);
+
+	if (dev == NULL) {
+		return;
+	}
+
+	const uint64_t before = k_cycle_get_64();
+	rtc_error_t ret = pcf85063a_read_register(dev, time_block, sizeof(time_block),
+						  RTC_TIME_REGISTER_ADDRESS);
+	const uint64_t after = k_cycle_get_64();
+
+	if (ret != RTC_SUCCESS || (time_block[SECONDS_INDEX] & RTC_OSCILLATOR_STOPPED) ||
+	    !rtc_time_block_is_valid(time_block)) {
+		LOG_ERR("Error %d: no valid time for drift measurement \n", ret);
+		calib.polling = false;
+		k_work_reschedule(&calib_work, periodic ? K_MSEC(RTC_CALIB_SAMPLE_INTERVAL_MS)
+							 : K_MSEC(MSEC_PER_SEC));
+		return;
+	}
+
+	const int64_t seconds = rtc_time_block_to_epoch(time_block);
+	const uint64_t read_cycles = before + (after - before) / 2;
+
+	if (calib.polling && seconds == calib.poll_seconds + 1) {
+		calib_apply_edge(dev, seconds,
+				 calib.poll_cycles + (read_cycles - calib.poll_cycles) / 2);
+		calib.polling = false;
+		if (periodic) {
+			k_work_reschedule(&calib_work, K_MSEC(RTC_CALIB_SAMPLE_INTERVAL_MS -
+							      RTC_CALIB_EDGE_GUARD_MS));
+		}
+		return;
+	}
+
+	// Still in the old second, or the window just opened
+	calib.polling = true;
+	calib.poll_seconds = seconds;
+	calib.poll_cycles = read_cycles;
+	k_work_reschedule(&calib_work, K_MSEC(RTC_CALIB_EDGE_POLL_MS));
+}
+
+/**
+ * @brief Starts measuring the RTC drift and correcting it through the Offset register
+ *
+ * The correction persisted by an earlier run is written to the chip first, so
+ * a power loss does not lose the calibration.
+ *
+ * @param dev Pointer to the RTC device
+ * @param reference Clock to measure the RTC against
+ * @return rtc_error_t RTC_ERROR_DEVICE_SETUP if the device is not ready, otherwise
+ *         the status of reading or restoring the Offset register
+ * @note Call after pcf85063a_initialize(), which sets the time but keeps the Offset
+ *       register. With CONFIG_SETTINGS, settings_subsys_init() must have run. Start
+ *       the engine again after setting the time on the chip.
+ */
+rtc_error_t pcf85063a_calib_start(const struct device *dev, rtc_calib_ref_t reference)
+{
+	int32_t correction_ppb;
+
+	if (dev == NULL || !device_is_ready(dev)) {
+		LOG_ERR("RTC device not ready for calibration \n");
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+	if (reference != RTC_CALIB_REF_CYCLES && reference != RTC_CALIB_REF_EXTERNAL) {
+		LOG_ERR("Unknown calibration reference %d \n", reference);
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	pcf85063a_calib_stop();
+
+	rtc_error_t ret = pcf85063a_get_offset(dev, &correction_ppb);
+#ifdef CONFIG_SETTINGS
+	int32_t stored_ppb;
+	if (ret == RTC_SUCCESS &&
+	    settings_load_subtree_direct(RTC_CALIB_SETTINGS_KEY, calib_settings_load,
+					 &stored_ppb) == 0 &&
+	    rtc_offset_from_ppb(stored_ppb) != rtc_offset_from_ppb(correction_ppb)) {
+		correction_ppb = stored_ppb;
+		ret = pcf85063a_set_offset(dev, correction_ppb);
+	}
+#endif
+	if (ret != RTC_SUCCESS) {
+		LOG_ERR("Error %d: failed to restore the offset correction \n", ret);
+		return ret;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&calib.lock);
+	calib.dev = dev;
+	calib.reference = reference;
+	calib.reference_pending = false;
+	calib.anchor_valid = false;
+	calib.polling = false;
+	calib.status = (struct pcf85063a_calib_status){
+		.correction_ppb = rtc_offset_to_ppb(rtc_offset_from_ppb(correction_ppb)),
+	};
+	k_spin_unlock(&calib.lock, key);
+
+	if (reference == RTC_CALIB_REF_CYCLES) {
+		k_work_reschedule(&calib_work, K_NO_WAIT);
+	}
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Stops the drift measurement, the Offset register keeps its value
+ */
+void pcf85063a_calib_stop(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&calib.lock);
+	calib.dev = NULL;
+	k_spin_unlock(&calib.lock, key);
+
+	k_work_cancel_delayable(&calib_work);
+}
+
+/**
+ * @brief Passes the current time of the external reference in
+ *
+ * The RTC second edge following the call is measured against it, so each call
+ * costs up to a second of polling the time registers. Calls an hour or more
+ * apart are enough, the drift is measured between the first and the latest.
+ *
+ * @param reference_us Reference time now, in microseconds on any fixed epoch
+ * @return rtc_error_t RTC_ERROR_DEVICE_SETUP unless the engine was started with
+ *         RTC_CALIB_REF_EXTERNAL
+ * @note Safe to call from any thread or ISR.
+ */
+rtc_error_t pcf85063a_calib_reference(int64_t reference_us)
+{
+	const uint64_t cycles = k_cycle_get_64();
+
+	k_spinlock_key_t key = k_spin_lock(&calib.lock);
+
+	if (calib.dev == NULL || calib.reference != RTC_CALIB_REF_EXTERNAL) {
+		k_spin_unlock(&calib.lock, key);
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	calib.reference_pending = true;
+	calib.reference_us = reference_us;
+	calib.reference_cycles = cycles;
+	k_spin_unlock(&calib.lock, key);
+
+	k_work_schedule(&calib_work, K_NO_WAIT);
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Returns the applied correction and the drift measured on top of it
+ *
+ * @param status Pointer to store the calibration state
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER for a NULL status
+ * @note The residual drift tells software clocks built on the RTC how far they
+ *       may run between resyncs.
+ */
+rtc_error_t pcf85063a_calib_status(struct pcf85063a_calib_status *status)
+{
+	if (status == NULL) {
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&calib.lock);
+	*status = calib.status;
+	k_spin_unlock(&calib.lock, key);
+
+	return RTC_SUCCESS;
+}
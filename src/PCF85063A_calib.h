@@ -0,0 +1,41 @@
+#ifndef PCF85063A_CALIB_H
+#define PCF85063A_CALIB_H
+
+#include <zephyr/device.h>
+#include "PCF85063A.h"
+
+// Against the CPU cycle counter an RTC second edge is measured every
+// RTC_CALIB_SAMPLE_INTERVAL_MS (a whole number of seconds). Polling for it starts
+// RTC_CALIB_EDGE_GUARD_MS before the expected edge and repeats every RTC_CALIB_EDGE_POLL_MS.
+#define RTC_CALIB_SAMPLE_INTERVAL_MS 600000
+#define RTC_CALIB_EDGE_GUARD_MS 20
+#define RTC_CALIB_EDGE_POLL_MS 1
+
+// The Offset register is only updated from drift measured over at least RTC_CALIB_MIN_SPAN_S,
+// where a millisecond of edge jitter is 0.28 ppm, well below one register step. Drift beyond
+// RTC_CALIB_MAX_DRIFT_PPM is taken as a time set on the chip and restarts the measurement.
+#define RTC_CALIB_MIN_SPAN_S 3600
+#define RTC_CALIB_MAX_DRIFT_PPM 1000
+
+// Settings key the correction is persisted under with CONFIG_SETTINGS
+#define RTC_CALIB_SETTINGS_KEY "pcf85063a/calib"
+
+// Clock the RTC is measured against
+typedef enum {
+    RTC_CALIB_REF_CYCLES = 0,   // CPU cycle counter, sampled every RTC_CALIB_SAMPLE_INTERVAL_MS
+    RTC_CALIB_REF_EXTERNAL = 1, // Times passed to pcf85063a_calib_reference(), e.g. from SNTP
+} rtc_calib_ref_t;
+
+struct pcf85063a_calib_status {
+    int32_t correction_ppb; // Correction in the Offset register
+    int32_t drift_ppb;      // Drift left on top of it, positive if the RTC runs fast
+    uint32_t span_s;        // RTC time drift_ppb was measured over
+    uint32_t updates;       // Offset register updates since the engine started
+};
+
+rtc_error_t pcf85063a_calib_start(const struct device *dev, rtc_calib_ref_t reference);
+void pcf85063a_calib_stop(void);
+rtc_error_t pcf85063a_calib_reference(int64_t reference_us);
+rtc_error_t pcf85063a_calib_status(struct pcf85063a_calib_status *status);
+
+#endif
@@ -0,0 +1,607 @@
+#include <string.h>
+#include "PCF85063A_bus.h"
+#include "PCF85063A_core.h"
+
+/**
+ * @brief Extracts a time component from a string and converts it to BCD format
+ *
+ * This function takes a time string (typically in the format "HH:MM:SS")
+ * and extracts a two-digit component starting at the specified index.
+ * It then converts this component to Binary Coded Decimal (BCD) format.
+ *
+ * @param time_str Pointer to the time string
+ * @param index Starting index of the time component to extract
+ * @return uint8_t The extracted time component in BCD format
+ */
+uint8_t extract_time_component(const char *time_str, int index)
+{
+	return ((time_str[index] - '0') << BCD_SHIFT) | (time_str[index + 1] - '0');
+}
+
+/**
+ * @brief Converts a decimal number to Binary Coded Decimal (BCD) format
+ *
+ * This function takes a decimal number (0-99) and converts it to BCD format.
+ * In BCD, each decimal digit is encoded in four bits.
+ *
+ * @param decimal The decimal number to convert (0-99)
+ * @return uint8_t The input number in BCD format
+ */
+uint8_t convert_to_bcd(uint8_t decimal)
+{
+	return ((decimal / 10) << BCD_SHIFT) | (decimal % 10);
+}
+
+/*
+ * Time block codec. The seven registers are packed little-endian into one
+ * 64-bit word (byte i holds register i, byte 7 is zero) so every field is
+ * converted with a handful of word operations instead of per-byte math.
+ */
+#define LANES_01 0x0101010101010101ULL
+#define LANES_0F 0x0F0F0F0F0F0F0F0FULL
+#define LANES_80 0x8080808080808080ULL
+#define LANES_16_00FF 0x00FF00FF00FF00FFULL
+#define LANES_16_000F 0x000F000F000F000FULL
+
+// Field masks strip OS, unused and 12-hour bits: sec, min, hr, day, weekday, month, year
+#define TIME_FIELD_MASKS 0x00FF1F073F3F7F7FULL
+
+// Per-field (127 - max) so adding it sets bit 7 of every field above its maximum.
+// The day lane is filled in per month.
+#define TIME_FIELD_LIMITS                                                                          \
+	((uint64_t)(127 - 59) | (uint64_t)(127 - 59) << 8 | (uint64_t)(127 - 23) << 16 |          \
+	 (uint64_t)(127 - 6) << 32 | (uint64_t)(127 - 12) << 40 | (uint64_t)(127 - 99) << 48)
+#define TIME_DAY_LANE_SHIFT (DATE_INDEX * 8)
+
+// Day and month must also be at least 1
+#define TIME_FIELD_NONZERO (0x7FULL << (DATE_INDEX * 8) | 0x7FULL << (MONTH_INDEX * 8))
+
+/**
+ * @brief Packs a time block into a word, register i in byte i
+ *
+ * @param block Pointer to 7 time registers
+ * @return uint64_t The packed block
+ */
+static inline uint64_t time_block_load(const uint8_t *block)
+{
+	return (uint64_t)block[0] | (uint64_t)block[1] << 8 | (uint64_t)block[2] << 16 |
+	       (uint64_t)block[3] << 24 | (uint64_t)block[4] << 32 | (uint64_t)block[5] << 40 |
+	       (uint64_t)block[6] << 48;
+}
+
+/**
+ * @brief Unpacks a word into a time block
+ *
+ * @param packed The packed block
+ * @param block Pointer to 7 time registers to fill
+ */
+static inline void time_block_store(uint64_t packed, uint8_t *block)
+{
+	for (int i = 0; i < RTC_TIME_REGISTER_SIZE; i++) {
+		block[i] = packed >> (i * 8);
+	}
+}
+
+/**
+ * @brief Converts every BCD byte of a word to binary
+ *
+ * Each byte is 16 * tens + units, so subtracting 6 * tens leaves 10 * tens + units.
+ * No byte can borrow from its neighbour.
+ *
+ * @param bcd Packed BCD bytes
+ * @return uint64_t Packed binary bytes
+ */
+static inline uint64_t bcd_word_to_binary(uint64_t bcd)
+{
+	return bcd - ((bcd >> BCD_SHIFT) & LANES_0F) * 6;
+}
+
+/**
+ * @brief Converts every binary byte (0-99) of a word to BCD
+ *
+ * Bytes are spread over 16-bit lanes so that tens = (value * 103) >> 10 cannot
+ * overflow into the next lane, then value + 6 * tens gives the BCD encoding.
+ *
+ * @param binary Packed binary bytes
+ * @return uint64_t Packed BCD bytes
+ */
+static inline uint64_t binary_word_to_bcd(uint64_t binary)
+{
+	uint64_t even = binary & LANES_16_00FF;
+	uint64_t odd = (binary >> 8) & LANES_16_00FF;
+
+	even += (((even * 103) >> 10) & LANES_16_000F) * 6;
+	odd += (((odd * 103) >> 10) & LANES_16_000F) * 6;
+
+	return even | (odd << 8);
+}
+
+/**
+ * @brief Flags every byte of a word that holds a nibble above 9
+ *
+ * @param bcd Packed BCD bytes
+ * @return uint64_t Non-zero if any nibble is not a decimal digit
+ */
+static inline uint64_t bcd_word_bad_nibbles(uint64_t bcd)
+{
+	const uint64_t low = bcd & LANES_0F;
+	const uint64_t high = (bcd >> BCD_SHIFT) & LANES_0F;
+
+	// A nibble above 9 carries into bit 4 once 6 is added
+	return ((low + LANES_01 * 6) | (high + LANES_01 * 6)) & (LANES_01 << 4);
+}
+
+/**
+ * @brief Checks a packed binary time block against the calendar
+ *
+ * @param binary Packed binary time block, nibbles already known to be valid
+ * @return bool True if every field is in range and the day exists in its month
+ */
+static inline bool binary_time_word_is_valid(uint64_t binary)
+{
+	// Indexed by month, 0 and 13-15 give a zero day limit that fails the check
+	static const uint8_t month_days[16] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	const uint8_t month = binary >> (MONTH_INDEX * 8);
+	const uint8_t year = binary >> (YEAR_INDEX * 8);
+	// 2000-2099: every fourth year is a leap year
+	const uint8_t max_day = month_days[month & 0x0F] + (month == 2 && (year & 3) == 0);
+
+	const uint64_t limits = TIME_FIELD_LIMITS | (uint64_t)(127 - max_day) << TIME_DAY_LANE_SHIFT;
+	const uint64_t too_large = (binary + limits) & LANES_80;
+	const uint64_t too_small = ~(binary + TIME_FIELD_NONZERO) & TIME_FIELD_NONZERO << 1 & LANES_80;
+
+	return (too_large | too_small) == 0;
+}
+
+/**
+ * @brief Checks that a BCD time block holds a real calendar time
+ *
+ * Rejects nibbles above 9, out of range fields and dates that don't exist,
+ * such as Feb 29 outside a leap year. OS and unused bits are ignored.
+ *
+ * @param time_block Pointer to an array containing time in format:
+ *                   sec, min, hr, day(1-31), weekday, month, year
+ * @return bool True if the block is valid
+ */
+bool rtc_time_block_is_valid(const uint8_t *time_block)
+{
+	const uint64_t bcd = time_block_load(time_block) & TIME_FIELD_MASKS;
+
+	return bcd_word_bad_nibbles(bcd) == 0 && binary_time_word_is_valid(bcd_word_to_binary(bcd));
+}
+
+/**
+ * @brief Checks that a BCD alarm block can be programmed
+ *
+ * A field with RTC_ALARM_FIELD_DISABLE (its AEN bit) set is left out of the
+ * match and its value is not checked. Enabled fields must be valid BCD values
+ * in range: the day 1-31 and the weekday 0-6. At least one field must be
+ * enabled, otherwise the alarm never fires.
+ *
+ * @param alarm_block Pointer to the 5 alarm registers: sec, min, hour, day, weekday
+ * @return bool True if the block is valid
+ */
+bool rtc_alarm_block_is_valid(const uint8_t *alarm_block)
+{
+	static const uint8_t limits[RTC_ALARM_REGISTER_SIZE] = {0x59, 0x59, 0x23, 0x31, 0x06};
+	// The alarm block shares the time block's first five fields
+	uint64_t bcd = 0;
+	bool enabled = false;
+
+	for (int i = 0; i < RTC_ALARM_REGISTER_SIZE; i++) {
+		if (alarm_block[i] & RTC_ALARM_FIELD_DISABLE) {
+			continue;
+		}
+		if (alarm_block[i] > limits[i]) {
+			return false;
+		}
+		bcd |= (uint64_t)alarm_block[i] << (i * 8);
+		enabled = true;
+	}
+
+	return enabled && !bcd_word_bad_nibbles(bcd) && alarm_block[DATE_INDEX] != 0;
+}
+
+/**
+ * @brief Converts a BCD time block to binary field values
+ *
+ * @param time_block Pointer to the 7 BCD time registers
+ * @param binary_block Pointer to 7 bytes receiving sec, min, hr, day, weekday, month, year
+ *                     as plain numbers, with OS and unused bits removed
+ */
+void rtc_time_block_to_binary(const uint8_t *time_block, uint8_t *binary_block)
+{
+	time_block_store(bcd_word_to_binary(time_block_load(time_block) & TIME_FIELD_MASKS),
+			 binary_block);
+}
+
+/**
+ * @brief Converts binary field values to a BCD time block
+ *
+ * @param binary_block Pointer to 7 bytes holding sec, min, hr, day, weekday, month, year
+ *                     as plain numbers (0-99)
+ * @param time_block Pointer to the 7 BCD time registers to fill
+ */
+void rtc_time_block_to_bcd(const uint8_t *binary_block, uint8_t *time_block)
+{
+	time_block_store(binary_word_to_bcd(time_block_load(binary_block)), time_block);
+}
+
+/**
+ * @brief Converts and validates an array of raw time block snapshots
+ *
+ * @param time_blocks Array of BCD time blocks, e.g. logged register dumps
+ * @param binary_blocks Array receiving the binary field values of each block
+ * @param count Number of blocks
+ * @return size_t Number of blocks that failed validation; they are still converted
+ */
+size_t rtc_time_blocks_to_binary(const uint8_t (*time_blocks)[RTC_TIME_REGISTER_SIZE],
+				 uint8_t (*binary_blocks)[RTC_TIME_REGISTER_SIZE], size_t count)
+{
+	size_t invalid = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		const uint64_t bcd = time_block_load(time_blocks[i]) & TIME_FIELD_MASKS;
+		const uint64_t binary = bcd_word_to_binary(bcd);
+
+		invalid += !(bcd_word_bad_nibbles(bcd) == 0 && binary_time_word_is_valid(binary));
+		time_block_store(binary, binary_blocks[i]);
+	}
+
+	return invalid;
+}
+
+/**
+ * @brief Converts a month name to its corresponding number
+ *
+ * This function takes a three-letter month name (e.g., "Jan", "Feb")
+ * and returns the corresponding month number (1-12).
+ *
+ * @param month_str Pointer to the month name string (3 characters)
+ * @return uint8_t The month number (1-12), or 0 if the month is not recognized
+ */
+uint8_t find_month(const char *month_str)
+{
+	const char *months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+				"Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+	for (int i = 0; i < 12; i++) {
+		if (strcmp(month_str, months[i]) == 0) {
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+// Days before each month of a non-leap year, indexed by month (1-12)
+static const uint16_t days_before_month[13] = {0,   0,   31,  59,  90,  120, 151,
+					       181, 212, 243, 273, 304, 334};
+
+// Last converted date as (days since 2000 << 16 | year << 9 | month << 5 | day)
+static uint32_t epoch_day_cache;
+
+/**
+ * @brief Converts a time block to seconds since 1970-01-01 00:00:00
+ *
+ * The chip only counts 2000-2099, where every fourth year is a leap year, so
+ * the day count needs no divisions. The day count of the last date converted
+ * is cached, so within a day only hours, minutes and seconds are recomputed.
+ *
+ * @param time_block Pointer to an array containing time in format:
+ *                   sec, min, hr, day(1-31), weekday, month, year
+ * @return int64_t Seconds since the Unix epoch
+ * @note The block is expected to be valid, see rtc_time_block_is_valid().
+ */
+int64_t rtc_time_block_to_epoch(const uint8_t *time_block)
+{
+	uint8_t fields[RTC_TIME_REGISTER_SIZE];
+	rtc_time_block_to_binary(time_block, fields);
+
+	const uint32_t year = fields[YEAR_INDEX];
+	const uint32_t month = fields[MONTH_INDEX] & 0x0F;
+	const uint32_t day = fields[DATE_INDEX] & 0x1F;
+	const uint32_t date_key = year << 9 | month << 5 | day;
+
+	uint32_t cached = __atomic_load_n(&epoch_day_cache, __ATOMIC_RELAXED);
+	uint32_t days;
+
+	if ((cached & 0xFFFF) == date_key && cached != 0) {
+		days = cached >> 16;
+	} else {
+		// Leap years before this one: 2000 itself counts once year > 0
+		days = year * 365 + ((year + 3) >> 2) + days_before_month[month] +
+		       (month > 2 && (year & 3) == 0) + day - 1;
+		__atomic_store_n(&epoch_day_cache, days << 16 | date_key, __ATOMIC_RELAXED);
+	}
+
+	return RTC_EPOCH_2000 + (int64_t)days * 86400 + fields[HOURS_INDEX] * 3600 +
+	       fields[MINUTES_INDEX] * 60 + fields[SECONDS_INDEX];
+}
+
+/**
+ * @brief Converts seconds since 1970-01-01 00:00:00 to a time block
+ *
+ * @param epoch Seconds since the Unix epoch, between RTC_EPOCH_2000 and RTC_EPOCH_MAX
+ * @param time_block Pointer to the 7 BCD time registers to fill, including weekday
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER if the time is outside 2000-2099
+ */
+rtc_error_t rtc_epoch_to_time_block(int64_t epoch, uint8_t *time_block)
+{
+	if (time_block == NULL || epoch < RTC_EPOCH_2000 || epoch > RTC_EPOCH_MAX) {
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	const uint32_t seconds = epoch - RTC_EPOCH_2000;
+	const uint32_t days = seconds / 86400;
+	const uint32_t second_of_day = seconds % 86400;
+
+	// Four-year cycles start with a leap year
+	uint32_t year = (days / 1461) * 4;
+	uint32_t day_of_year = days % 1461;
+	if (day_of_year >= 366) {
+		year += 1 + (day_of_year - 366) / 365;
+		day_of_year = (day_of_year - 366) % 365;
+	}
+
+	const uint32_t leap = (year & 3) == 0;
+	uint32_t month = 12;
+	while (days_before_month[month] + (month > 2 ? leap : 0) > day_of_year) {
+		month--;
+	}
+
+	const uint8_t fields[RTC_TIME_REGISTER_SIZE] = {
+		[SECONDS_INDEX] = second_of_day % 60,
+		[MINUTES_INDEX] = (second_of_day / 60) % 60,
+		[HOURS_INDEX] = second_of_day / 3600,
+		[DATE_INDEX] = day_of_year - days_before_month[month] - (month > 2 ? leap : 0) + 1,
+		// 2000-01-01 was a Saturday
+		[WEEKDAY_INDEX] = (days + 6) % 7,
+		[MONTH_INDEX] = month,
+		[YEAR_INDEX] = year,
+	};
+	rtc_time_block_to_bcd(fields, time_block);
+
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Looks up the UTC offset in effect at a UTC time
+ *
+ * The interval at *hint is tried first, so lookups near the previous one cost
+ * two compares. Anything else is a binary search over the transitions, which
+ * moves *hint to the interval found.
+ *
+ * @param table Transitions of the time zone, at least one
+ * @param utc_epoch Seconds since the Unix epoch, UTC
+ * @param hint Interval of the previous lookup, any value to start with
+ * @return int32_t UTC offset in seconds, local time is utc_epoch plus this
+ */
+int32_t rtc_tz_offset(const struct rtc_tz_table *table, int64_t utc_epoch, size_t *hint)
+{
+	// The table ends in 2100, clamp instead of wrapping
+	uint32_t seconds = UINT32_MAX;
+	if (utc_epoch < 0) {
+		seconds = 0;
+	} else if (utc_epoch < UINT32_MAX) {
+		seconds = (uint32_t)utc_epoch;
+	}
+	size_t index = *hint;
+
+	if (index >= table->count || table->starts[index] > seconds ||
+	    (index + 1 < table->count && table->starts[index + 1] <= seconds)) {
+		// Last transition at or before seconds, starts[0] is 0 so there always is one
+		size_t low = 0;
+		size_t high = table->count;
+		while (high - low > 1) {
+			const size_t middle = low + (high - low) / 2;
+			if (table->starts[middle] <= seconds) {
+				low = middle;
+			} else {
+				high = middle;
+			}
+		}
+		index = low;
+		*hint = index;
+	}
+
+	return table->offsets[index] * 60;
+}
+
+/**
+ * @brief Computes how far the RTC ran ahead of a reference clock
+ *
+ * @param rtc_elapsed_us Time the RTC counted over the interval
+ * @param reference_elapsed_us Time the reference counted over the same interval, positive
+ * @return int32_t Drift in parts per billion, positive if the RTC runs fast, saturated
+ *         to the int32_t range and 0 for an empty interval
+ */
+int32_t rtc_drift_ppb(int64_t rtc_elapsed_us, int64_t reference_elapsed_us)
+{
+	if (reference_elapsed_us <= 0) {
+		return 0;
+	}
+
+	int64_t difference = rtc_elapsed_us - reference_elapsed_us;
+
+	if (difference > 2 * reference_elapsed_us) {
+		return INT32_MAX;
+	} else if (difference < -2 * reference_elapsed_us) {
+		return INT32_MIN;
+	}
+	// Differences of hours are nowhere near microsecond precision anyway, scale them
+	// down until the product below cannot overflow
+	while (difference > 9000000000LL || difference < -9000000000LL) {
+		reference_elapsed_us /= 2;
+		difference /= 2;
+	}
+
+	const int64_t ppb = difference * 1000000000LL / reference_elapsed_us;
+	if (ppb > INT32_MAX) {
+		return INT32_MAX;
+	} else if (ppb < INT32_MIN) {
+		return INT32_MIN;
+	}
+	return (int32_t)ppb;
+}
+
+/**
+ * @brief Rounds a register correction to a number of Offset register steps
+ *
+ * @param register_ppb Correction in parts per billion, positive to slow the clock down
+ * @param step_ppb Size of one step
+ * @return int32_t Nearest step count, clamped to the register range
+ */
+static int32_t offset_steps(int64_t register_ppb, int32_t step_ppb)
+{
+	const int64_t half = step_ppb / 2;
+	const int64_t steps = register_ppb >= 0 ? (register_ppb + half) / step_ppb
+						: (register_ppb - half) / step_ppb;
+
+	if (steps > RTC_OFFSET_MAX) {
+		return RTC_OFFSET_MAX;
+	} else if (steps < RTC_OFFSET_MIN) {
+		return RTC_OFFSET_MIN;
+	}
+	return (int32_t)steps;
+}
+
+/**
+ * @brief Encodes a frequency correction as an Offset register value
+ *
+ * The chip drops clock pulses for a positive register value, so the register
+ * holds the correction with its sign flipped. Normal mode is used unless fast
+ * mode gets closer to the correction, since fast mode draws more current.
+ *
+ * @param correction_ppb Correction in parts per billion, positive to speed the clock up
+ * @return uint8_t Offset register value closest to the correction
+ */
+uint8_t rtc_offset_from_ppb(int32_t correction_ppb)
+{
+	const int64_t register_ppb = -(int64_t)correction_ppb;
+	const int32_t normal = offset_steps(register_ppb, RTC_OFFSET_NORMAL_STEP_PPB);
+	const int32_t fast = offset_steps(register_ppb, RTC_OFFSET_FAST_STEP_PPB);
+	int64_t normal_error = register_ppb - (int64_t)normal * RTC_OFFSET_NORMAL_STEP_PPB;
+	int64_t fast_error = register_ppb - (int64_t)fast * RTC_OFFSET_FAST_STEP_PPB;
+
+	normal_error = normal_error < 0 ? -normal_error : normal_error;
+	fast_error = fast_error < 0 ? -fast_error : fast_error;
+	if (fast_error < normal_error) {
+		return RTC_OFFSET_MODE | ((uint8_t)fast & RTC_OFFSET_MASK);
+	}
+	return (uint8_t)normal & RTC_OFFSET_MASK;
+}
+
+/**
+ * @brief Decodes an Offset register value
+ *
+ * @param offset Offset register value
+ * @return int32_t Correction it applies in parts per billion, positive speeds the clock up
+ */
+int32_t rtc_offset_to_ppb(uint8_t offset)
+{
+	// Sign-extend the 7-bit field
+	const int32_t steps = (int32_t)(offset & RTC_OFFSET_MASK) - ((offset & 0x40) ? 0x80 : 0);
+
+	return -steps * ((offset & RTC_OFFSET_MODE) ? RTC_OFFSET_FAST_STEP_PPB
+						     : RTC_OFFSET_NORMAL_STEP_PPB);
+}
+
+/**
+ * @brief Tells whether an operation may go to the bus
+ *
+ * An open breaker turns half-open once its open time is over and lets the
+ * caller through as the probe. Further callers fail until the probe is recorded.
+ *
+ * @param breaker Breaker of the bus
+ * @param now_ms Current time in ms
+ * @return bool True if the operation may go to the bus
+ */
+bool rtc_breaker_allow(struct rtc_breaker *breaker, int64_t now_ms)
+{
+	switch (breaker->state) {
+	case RTC_BREAKER_CLOSED:
+		return true;
+	case RTC_BREAKER_OPEN:
+		if (now_ms < breaker->open_until_ms) {
+			return false;
+		}
+		breaker->state = RTC_BREAKER_HALF_OPEN;
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * @brief Records the outcome of an operation rtc_breaker_allow() let through
+ *
+ * A success closes the breaker. It opens after trip_failures failures in a
+ * row, or after one failed probe.
+ *
+ * @param breaker Breaker of the bus
+ * @param policy Policy giving the trip threshold and the open time
+ * @param success True if the operation succeeded
+ * @param now_ms Current time in ms
+ * @return bool True if this failure opened the breaker
+ */
+bool rtc_breaker_record(struct rtc_breaker *breaker, const struct rtc_bus_policy *policy,
+			bool success, int64_t now_ms)
+{
+	if (success) {
+		breaker->state = RTC_BREAKER_CLOSED;
+		breaker->failures = 0;
+		return false;
+	}
+
+	if (breaker->failures < UINT8_MAX) {
+		breaker->failures++;
+	}
+	if (breaker->state != RTC_BREAKER_HALF_OPEN && breaker->failures < policy->trip_failures) {
+		return false;
+	}
+
+	breaker->state = RTC_BREAKER_OPEN;
+	breaker->open_until_ms = now_ms + policy->open_ms;
+	breaker->trips++;
+	return true;
+}
+
+/**
+ * @brief Returns the wait before a retry
+ *
+ * @param policy Policy giving the first backoff
+ * @param retry Number of the retry, 0 for the first
+ * @return uint32_t Backoff in ms, doubled per retry and capped at the operation deadline
+ */
+uint32_t rtc_retry_backoff_ms(const struct rtc_bus_policy *policy, uint8_t retry)
+{
+	const uint64_t backoff = (uint64_t)policy->backoff_ms << (retry < 16 ? retry : 16);
+
+	return backoff < policy->deadline_ms ? (uint32_t)backoff : policy->deadline_ms;
+}
+
+/**
+ * @brief Reads the time block over a bus and decodes it
+ *
+ * @param bus Bus the chip is on
+ * @param fields Pointer to 7 bytes receiving sec, min, hr, day, weekday, month, year
+ *               as plain numbers
+ * @return rtc_error_t RTC_ERROR_I2C_READ if the bus failed, RTC_ERROR_INVALID_PARAMETER
+ *         if the oscillator stopped since the time was set or the time is invalid
+ */
+rtc_error_t pcf85063a_bus_get_time(const struct pcf85063a_bus *bus, uint8_t *fields)
+{
+	uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+
+	int ret = pcf85063a_bus_read(bus, RTC_TIME_REGISTER_ADDRESS, time_block, sizeof(time_block));
+	if (ret != 0) {
+		return RTC_ERROR_I2C_READ;
+	}
+
+	if ((time_block[SECONDS_INDEX] & RTC_OSCILLATOR_STOPPED) ||
+	    !rtc_time_block_is_valid(time_block)) {
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	rtc_time_block_to_binary(time_block, fields);
+	return RTC_SUCCESS;
+}
@@ -0,0 +1,172 @@
+#ifndef PCF85063A_CORE_H
+#define PCF85063A_CORE_H
+
+/*
+ * Register map, time codec, validation and calendar logic of the PCF85063A.
+ * Nothing here depends on Zephyr, so it also builds as a plain host library,
+ * see tests/host.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SECONDS_INDEX 0
+#define MINUTES_INDEX 1
+#define HOURS_INDEX 2
+#define DATE_INDEX 3
+#define WEEKDAY_INDEX 4
+#define MONTH_INDEX 5
+#define YEAR_INDEX 6
+#define TIME_HOURS_INDEX 0
+#define TIME_MINUTES_INDEX 3
+#define TIME_SECONDS_INDEX 6
+#define BCD_SHIFT 4
+
+#define RTC_REGISTER_SIZE 18
+#define RTC_ALARM_REGISTER_SIZE 5
+#define RTC_TIME_REGISTER_ADDRESS 0x04
+#define RTC_ALARM_REGISTER_ADDRESS 0x0B
+#define RTC_TIME_REGISTER_SIZE 7
+#define ENABLE_ALARM 0x80
+#define ALARM_CONTROL_REGISTER 1
+
+#define RTC_CONTROL_1_ADDRESS 0x00
+#define RTC_CONTROL_2_ADDRESS 0x01
+#define RTC_OFFSET_ADDRESS 0x02
+#define RTC_RAM_BYTE_ADDRESS 0x03
+#define RTC_TIMER_VALUE_ADDRESS 0x10
+#define RTC_TIMER_MODE_ADDRESS 0x11
+#define RTC_SOFTWARE_RESET 0x58
+#define RTC_CTRL1_CAP_SEL 0x01
+#define RTC_CTRL2_AIE ENABLE_ALARM
+#define RTC_CTRL2_AF 0x40
+#define RTC_CTRL2_MI 0x20
+#define RTC_CTRL2_HMI 0x10
+#define RTC_CTRL2_TF 0x08
+#define RTC_CTRL2_COF_MASK 0x07
+// Offset register: 7-bit two's complement correction, a positive value slows the clock
+// down. MODE clear applies it every 2 hours in 4.34 ppm steps, set every 4 minutes in
+// 4.069 ppm steps.
+#define RTC_OFFSET_MODE 0x80
+#define RTC_OFFSET_MASK 0x7F
+#define RTC_OFFSET_MIN (-64)
+#define RTC_OFFSET_MAX 63
+#define RTC_OFFSET_NORMAL_STEP_PPB 4340
+#define RTC_OFFSET_FAST_STEP_PPB 4069
+// Corrections the register can apply, normal mode reaches furthest
+#define RTC_OFFSET_MIN_PPB (-RTC_OFFSET_MAX * RTC_OFFSET_NORMAL_STEP_PPB)
+#define RTC_OFFSET_MAX_PPB (-RTC_OFFSET_MIN * RTC_OFFSET_NORMAL_STEP_PPB)
+#define RTC_TIMER_MODE_TCF_SHIFT 3
+#define RTC_TIMER_MODE_TCF_MASK 0x18
+#define RTC_TIMER_MODE_TE 0x04
+#define RTC_TIMER_MODE_TIE 0x02
+#define RTC_TIMER_MODE_TI_TP 0x01
+#define RTC_OSCILLATOR_STOPPED 0x80
+#define RTC_ALARM_FIELD_DISABLE 0x80
+#define RTC_SECONDS_MASK 0x7F
+#define RTC_MINUTES_MASK 0x7F
+#define RTC_HOURS_MASK 0x3F
+#define RTC_DATE_MASK 0x3F
+#define RTC_MONTH_MASK 0x1F
+#define RTC_WEEKDAY_MASK 0x07
+#define RTC_BASE_YEAR 2000
+// struct rtc_time counts years from 1900, the chip covers 2000-2099
+#define RTC_TM_YEAR_MIN (RTC_BASE_YEAR - 1900)
+#define RTC_TM_YEAR_MAX (RTC_TM_YEAR_MIN + 99)
+// Unix time of 2000-01-01 00:00:00 and 2099-12-31 23:59:59
+#define RTC_EPOCH_2000 946684800LL
+#define RTC_EPOCH_MAX 4102444799LL
+#define RTC_TIME_REGISTER_MASK                                                                     \
+	(((1UL << RTC_TIME_REGISTER_SIZE) - 1) << RTC_TIME_REGISTER_ADDRESS)
+
+// Registers the chip changes on its own (Control_2 flags, time block, timer countdown).
+// Reads touching any of these always go to the bus, everything else is served from the shadow.
+#define RTC_VOLATILE_REGISTERS                                                                     \
+	((1UL << RTC_CONTROL_2_ADDRESS) | RTC_TIME_REGISTER_MASK | (1UL << RTC_TIMER_VALUE_ADDRESS))
+
+typedef enum {
+    RTC_SUCCESS = 0,
+    RTC_ERROR_DEVICE_SETUP = -1,
+    RTC_ERROR_I2C_WRITE = -2,
+    RTC_ERROR_I2C_READ = -3,
+    RTC_ERROR_INVALID_PARAMETER = -4,
+    RTC_ERROR_GPIO_CONFIG = -5,
+    RTC_ERROR_TIMEOUT = -6,         // The operation deadline passed
+    RTC_ERROR_BUS_UNAVAILABLE = -7, // The bus is known bad, the operation was not tried
+} rtc_error_t;
+
+// UTC offset transitions of one time zone, as generated by cmake/pcf85063a_tz_table.py
+struct rtc_tz_table {
+    const uint32_t *starts; // UTC seconds each offset starts at, ascending, starts[0] is 0
+    const int16_t *offsets; // UTC offsets in minutes
+    size_t count;
+};
+
+// Retry and circuit breaker policy of bus operations
+struct rtc_bus_policy {
+    uint32_t deadline_ms;  // Budget of one operation for waiting on the device, retries and backoff
+    uint8_t retries;       // Attempts after the first one
+    uint16_t backoff_ms;   // Wait before the first retry, doubled for each further one
+    uint8_t trip_failures; // Failed operations in a row that open the breaker
+    uint32_t open_ms;      // Time the open breaker fails operations before letting a probe through
+};
+
+typedef enum {
+    RTC_BREAKER_CLOSED = 0,    // Operations go to the bus
+    RTC_BREAKER_OPEN = 1,      // The bus is known bad, operations fail without touching it
+    RTC_BREAKER_HALF_OPEN = 2, // A probe operation is on the bus and decides the next state
+} rtc_breaker_state_t;
+
+struct rtc_breaker {
+    rtc_breaker_state_t state;
+    uint8_t failures;      // Failed operations in a row
+    int64_t open_until_ms; // When an open breaker lets the next probe through
+    uint32_t trips;        // Times the breaker opened
+};
+
+/**
+ * @brief Builds the register bitmask covering a contiguous register range
+ *
+ * @param start_address First register of the range
+ * @param size Number of registers in the range
+ * @return uint32_t Mask with one bit set per register in the range
+ */
+static inline uint32_t register_range_mask(const uint8_t start_address, const uint8_t size)
+{
+	return ((1UL << size) - 1) << start_address;
+}
+
+/**
+ * @brief Converts a BCD byte to its decimal value
+ *
+ * @param bcd The BCD value to convert (0x00-0x99)
+ * @return uint8_t The decimal value (0-99)
+ */
+static inline uint8_t bcd_to_decimal(uint8_t bcd)
+{
+	return (bcd >> BCD_SHIFT) * 10 + (bcd & 0x0F);
+}
+
+uint8_t extract_time_component(const char *time_str, int index);
+uint8_t convert_to_bcd(uint8_t decimal);
+uint8_t find_month(const char *month_str);
+
+bool rtc_time_block_is_valid(const uint8_t *time_block);
+bool rtc_alarm_block_is_valid(const uint8_t *alarm_block);
+void rtc_time_block_to_binary(const uint8_t *time_block, uint8_t *binary_block);
+void rtc_time_block_to_bcd(const uint8_t *binary_block, uint8_t *time_block);
+size_t rtc_time_blocks_to_binary(const uint8_t (*time_blocks)[RTC_TIME_REGISTER_SIZE],
+				 uint8_t (*binary_blocks)[RTC_TIME_REGISTER_SIZE], size_t count);
+int64_t rtc_time_block_to_epoch(const uint8_t *time_block);
+rtc_error_t rtc_epoch_to_time_block(int64_t epoch, uint8_t *time_block);
+int32_t rtc_tz_offset(const struct rtc_tz_table *table, int64_t utc_epoch, size_t *hint);
+int32_t rtc_drift_ppb(int64_t rtc_elapsed_us, int64_t reference_elapsed_us);
+uint8_t rtc_offset_from_ppb(int32_t correction_ppb);
+int32_t rtc_offset_to_ppb(uint8_t offset);
+bool rtc_breaker_allow(struct rtc_breaker *breaker, int64_t now_ms);
+bool rtc_breaker_record(struct rtc_breaker *breaker, const struct rtc_bus_policy *policy,
+			bool success, int64_t now_ms);
+uint32_t rtc_retry_backoff_ms(const struct rtc_bus_policy *policy, uint8_t retry);
+
+#endif
@@ -0,0 +1,424 @@
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include "PCF85063A.h"
+#include "PCF85063A_emul.h"
+
+#define DT_DRV_COMPAT nxp_pcf85063a
+
+LOG_MODULE_REGISTER(pcf85063a_emul, CONFIG_PCF85063A_LOG_LEVEL);
+
+// Virtual time runs in ticks of the fastest timer source, 4096 Hz
+#define EMUL_TICKS_PER_SECOND 4096
+#define EMUL_CTRL1_STOP 0x20
+
+// Register contents after power-on or a software reset
+static const uint8_t reset_registers[RTC_REGISTER_SIZE] = {
+	0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x01, 0x06,
+	0x01, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x18,
+};
+
+// Timer period in emulator ticks for each TCF source: 4096 Hz, 64 Hz, 1 Hz, 1/60 Hz
+static const uint32_t timer_periods[] = {1, 64, EMUL_TICKS_PER_SECOND, 60 * EMUL_TICKS_PER_SECOND};
+
+struct pcf85063a_emul_config {
+	struct gpio_dt_spec int_gpio;
+};
+
+struct pcf85063a_emul_data {
+	uint8_t registers[RTC_REGISTER_SIZE];
+	uint8_t pointer;
+	uint8_t timer_reload;
+	uint32_t second_phase; // Ticks since the last second rollover
+	uint32_t timer_phase;  // Ticks since the last timer decrement
+	uint32_t ms_remainder; // Sub-tick part of advanced time, in 1/1000 ticks
+	bool int_asserted;
+	uint32_t fail_transfers; // Transfers still to fail with fail_error
+	int fail_error;
+};
+
+/**
+ * @brief Adds one to a BCD register and wraps it back to first past last
+ *
+ * @param value Pointer to the BCD register
+ * @param first Value after wrapping, in decimal
+ * @param last Last valid value, in decimal
+ * @return bool True if the register wrapped
+ */
+static bool bcd_increment(uint8_t *value, uint8_t first, uint8_t last)
+{
+	uint8_t decimal = (*value >> BCD_SHIFT) * 10 + (*value & 0x0F);
+
+	if (decimal >= last) {
+		*value = convert_to_bcd(first);
+		return true;
+	}
+
+	*value = convert_to_bcd(decimal + 1);
+	return false;
+}
+
+/**
+ * @brief Returns the number of days in the month held by the time block
+ *
+ * @param registers Pointer to the register map
+ * @return uint8_t Days in the current month, leap years follow the 2000-2099 rule
+ */
+static uint8_t days_in_month(const uint8_t *registers)
+{
+	static const uint8_t days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	const uint8_t *time = &registers[RTC_TIME_REGISTER_ADDRESS];
+	uint8_t month = (time[MONTH_INDEX] >> BCD_SHIFT) * 10 + (time[MONTH_INDEX] & 0x0F);
+	uint8_t year = (time[YEAR_INDEX] >> BCD_SHIFT) * 10 + (time[YEAR_INDEX] & 0x0F);
+
+	if (month < 1 || month > 12) {
+		return 31;
+	}
+
+	return days[month - 1] + (month == 2 && (year % 4) == 0);
+}
+
+/**
+ * @brief Drives the INT line from the flag and enable bits
+ *
+ * @param target Pointer to the emulator
+ * @param pulse True to emit a pulse even if the line level does not change
+ */
+static void update_int(const struct emul *target, bool pulse)
+{
+	const struct pcf85063a_emul_config *config = target->cfg;
+	struct pcf85063a_emul_data *data = target->data;
+	const uint8_t control_2 = data->registers[RTC_CONTROL_2_ADDRESS];
+	const uint8_t timer_mode = data->registers[RTC_TIMER_MODE_ADDRESS];
+
+	if (config->int_gpio.port == NULL) {
+		return;
+	}
+
+	bool level = ((control_2 & RTC_CTRL2_AIE) && (control_2 & RTC_CTRL2_AF)) ||
+		     ((control_2 & RTC_CTRL2_TF) && (timer_mode & RTC_TIMER_MODE_TIE) &&
+		      !(timer_mode & RTC_TIMER_MODE_TI_TP));
+
+	// INT is open drain and active low
+	if (pulse && !level) {
+		gpio_emul_input_set(config->int_gpio.port, config->int_gpio.pin, 0);
+	}
+
+	if (level != data->int_asserted || pulse) {
+		gpio_emul_input_set(config->int_gpio.port, config->int_gpio.pin, level ? 0 : 1);
+	}
+
+	data->int_asserted = level;
+}
+
+/**
+ * @brief Checks the enabled alarm fields against the time block
+ *
+ * @param registers Pointer to the register map
+ * @return bool True if at least one field is enabled and all enabled fields match
+ */
+static bool alarm_matches(const uint8_t *registers)
+{
+	static const uint8_t masks[RTC_ALARM_REGISTER_SIZE] = {
+		RTC_SECONDS_MASK, RTC_MINUTES_MASK, RTC_HOURS_MASK, RTC_DATE_MASK, RTC_WEEKDAY_MASK,
+	};
+	const uint8_t *alarm = &registers[RTC_ALARM_REGISTER_ADDRESS];
+	const uint8_t *time = &registers[RTC_TIME_REGISTER_ADDRESS];
+	bool enabled = false;
+
+	for (int i = 0; i < RTC_ALARM_REGISTER_SIZE; i++) {
+		if (alarm[i] & RTC_ALARM_FIELD_DISABLE) {
+			continue;
+		}
+		if ((alarm[i] & masks[i]) != (time[i] & masks[i])) {
+			return false;
+		}
+		enabled = true;
+	}
+
+	return enabled;
+}
+
+/**
+ * @brief Advances the time block by one second with calendar rollover
+ *
+ * @param target Pointer to the emulator
+ */
+static void second_tick(const struct emul *target)
+{
+	struct pcf85063a_emul_data *data = target->data;
+	uint8_t *time = &data->registers[RTC_TIME_REGISTER_ADDRESS];
+	uint8_t *control_2 = &data->registers[RTC_CONTROL_2_ADDRESS];
+	const uint8_t os_flag = time[SECONDS_INDEX] & RTC_OSCILLATOR_STOPPED;
+	bool pulse = false;
+
+	time[SECONDS_INDEX] &= RTC_SECONDS_MASK;
+	if (bcd_increment(&time[SECONDS_INDEX], 0, 59) &&
+	    bcd_increment(&time[MINUTES_INDEX], 0, 59) &&
+	    bcd_increment(&time[HOURS_INDEX], 0, 23)) {
+		time[WEEKDAY_INDEX] = (time[WEEKDAY_INDEX] + 1) % 7;
+		if (bcd_increment(&time[DATE_INDEX], 1, days_in_month(data->registers)) &&
+		    bcd_increment(&time[MONTH_INDEX], 1, 12)) {
+			bcd_increment(&time[YEAR_INDEX], 0, 99);
+		}
+	}
+	time[SECONDS_INDEX] |= os_flag;
+
+	if (alarm_matches(data->registers)) {
+		*control_2 |= RTC_CTRL2_AF;
+	}
+
+	const uint8_t seconds = time[SECONDS_INDEX] & RTC_SECONDS_MASK;
+	if (((*control_2 & RTC_CTRL2_MI) && seconds == 0x00) ||
+	    ((*control_2 & RTC_CTRL2_HMI) && (seconds == 0x00 || seconds == 0x30))) {
+		*control_2 |= RTC_CTRL2_TF;
+		pulse = true;
+	}
+
+	update_int(target, pulse);
+}
+
+/**
+ * @brief Decrements the countdown timer and reloads it on expiry
+ *
+ * @param target Pointer to the emulator
+ */
+static void timer_tick(const struct emul *target)
+{
+	struct pcf85063a_emul_data *data = target->data;
+	uint8_t *timer_value = &data->registers[RTC_TIMER_VALUE_ADDRESS];
+
+	if (*timer_value > 1) {
+		(*timer_value)--;
+		return;
+	}
+
+	const uint8_t timer_mode = data->registers[RTC_TIMER_MODE_ADDRESS];
+
+	*timer_value = data->timer_reload;
+	data->registers[RTC_CONTROL_2_ADDRESS] |= RTC_CTRL2_TF;
+	update_int(target, (timer_mode & RTC_TIMER_MODE_TIE) && (timer_mode & RTC_TIMER_MODE_TI_TP));
+}
+
+/**
+ * @brief Advances virtual time, running every second and timer event it covers
+ *
+ * @param target Pointer to the emulator
+ * @param ms Milliseconds of virtual time to run
+ * @return int 0 on success
+ */
+int pcf85063a_emul_advance(const struct emul *target, uint32_t ms)
+{
+	struct pcf85063a_emul_data *data = target->data;
+	uint64_t scaled = (uint64_t)ms * EMUL_TICKS_PER_SECOND + data->ms_remainder;
+	uint64_t ticks = scaled / MSEC_PER_SEC;
+
+	data->ms_remainder = scaled % MSEC_PER_SEC;
+
+	while (ticks > 0) {
+		const uint8_t timer_mode = data->registers[RTC_TIMER_MODE_ADDRESS];
+		const bool running = !(data->registers[RTC_CONTROL_1_ADDRESS] & EMUL_CTRL1_STOP);
+		const bool timer_enabled = (timer_mode & RTC_TIMER_MODE_TE) && data->timer_reload;
+		const uint32_t timer_period =
+			timer_periods[(timer_mode & RTC_TIMER_MODE_TCF_MASK) >>
+				      RTC_TIMER_MODE_TCF_SHIFT];
+
+		// Jump straight to the next event instead of stepping every tick
+		uint64_t step = ticks;
+		if (running) {
+			step = MIN(step, EMUL_TICKS_PER_SECOND - data->second_phase);
+		}
+		if (timer_enabled) {
+			step = MIN(step, timer_period - data->timer_phase);
+		}
+		ticks -= step;
+
+		if (running) {
+			data->second_phase += step;
+			if (data->second_phase == EMUL_TICKS_PER_SECOND) {
+				data->second_phase = 0;
+				second_tick(target);
+			}
+		}
+
+		if (timer_enabled) {
+			data->timer_phase += step;
+			if (data->timer_phase == timer_period) {
+				data->timer_phase = 0;
+				timer_tick(target);
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Copies the full register map out of the emulator
+ *
+ * @param target Pointer to the emulator
+ * @param registers Pointer to an array of RTC_REGISTER_SIZE bytes
+ */
+void pcf85063a_emul_get_registers(const struct emul *target, uint8_t *registers)
+{
+	struct pcf85063a_emul_data *data = target->data;
+
+	memcpy(registers, data->registers, RTC_REGISTER_SIZE);
+}
+
+/**
+ * @brief Overwrites the full register map, bypassing the bus
+ *
+ * @param target Pointer to the emulator
+ * @param registers Pointer to an array of RTC_REGISTER_SIZE bytes
+ */
+void pcf85063a_emul_set_registers(const struct emul *target, const uint8_t *registers)
+{
+	struct pcf85063a_emul_data *data = target->data;
+
+	memcpy(data->registers, registers, RTC_REGISTER_SIZE);
+	data->timer_reload = registers[RTC_TIMER_VALUE_ADDRESS];
+	update_int(target, false);
+}
+
+/**
+ * @brief Makes the next bus transfers fail, e.g. to model a stuck bus
+ *
+ * @param target Pointer to the emulator
+ * @param count Number of transfers to fail, 0 to stop failing
+ * @param error Negative errno the failed transfers return
+ */
+void pcf85063a_emul_fail_transfers(const struct emul *target, uint32_t count, int error)
+{
+	struct pcf85063a_emul_data *data = target->data;
+
+	data->fail_error = error;
+	data->fail_transfers = count;
+}
+
+/**
+ * @brief Applies a bus write to one register with the chip's side effects
+ *
+ * @param target Pointer to the emulator
+ * @param address Register being written
+ * @param value Value written
+ */
+static void write_one(const struct emul *target, uint8_t address, uint8_t value)
+{
+	struct pcf85063a_emul_data *data = target->data;
+
+	switch (address) {
+	case RTC_CONTROL_1_ADDRESS:
+		if (value == RTC_SOFTWARE_RESET) {
+			memcpy(data->registers, reset_registers, RTC_REGISTER_SIZE);
+			data->timer_reload = 0;
+			data->second_phase = 0;
+			data->timer_phase = 0;
+			return;
+		}
+		break;
+	case RTC_CONTROL_2_ADDRESS:
+		// AF and TF can only be cleared, writing 1 leaves them unchanged
+		value &= data->registers[address] | ~(RTC_CTRL2_AF | RTC_CTRL2_TF);
+		break;
+	case RTC_TIME_REGISTER_ADDRESS:
+		// Writing the seconds register restarts the prescaler
+		data->second_phase = 0;
+		break;
+	case RTC_TIMER_VALUE_ADDRESS:
+		data->timer_reload = value;
+		data->timer_phase = 0;
+		break;
+	default:
+		break;
+	}
+
+	data->registers[address] = value;
+}
+
+/**
+ * @brief I2C emulator transfer hook
+ *
+ * The first written byte of a transfer sets the register pointer, further bytes
+ * are written with auto-increment. Reads continue from the pointer. Both wrap
+ * from the last register back to Control_1 like the chip. Transfers set to fail
+ * by pcf85063a_emul_fail_transfers() leave the chip untouched.
+ */
+static int pcf85063a_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs,
+				   int addr)
+{
+	struct pcf85063a_emul_data *data = target->data;
+	bool pointer_set = false;
+
+	if (data->fail_transfers > 0) {
+		data->fail_transfers--;
+		return data->fail_error;
+	}
+
+	for (int i = 0; i < num_msgs; i++) {
+		struct i2c_msg *msg = &msgs[i];
+
+		// A repeated start begins a new burst with its own register address
+		if (msg->flags & I2C_MSG_RESTART) {
+			pointer_set = false;
+		}
+
+		for (uint32_t j = 0; j < msg->len; j++) {
+			if (msg->flags & I2C_MSG_READ) {
+				msg->buf[j] = data->registers[data->pointer];
+			} else if (!pointer_set) {
+				if (msg->buf[j] >= RTC_REGISTER_SIZE) {
+					return -EIO;
+				}
+				data->pointer = msg->buf[j];
+				pointer_set = true;
+				continue;
+			} else {
+				write_one(target, data->pointer, msg->buf[j]);
+			}
+			data->pointer = (data->pointer + 1) % RTC_REGISTER_SIZE;
+		}
+	}
+
+	update_int(target, false);
+	return 0;
+}
+
+static const struct i2c_emul_api pcf85063a_emul_api = {
+	.transfer = pcf85063a_emul_transfer,
+};
+
+/**
+ * @brief Emulator init hook, powers the model up with the chip's reset values
+ *
+ * @param target Pointer to the emulator
+ * @param parent Pointer to the emulated I2C controller
+ * @return int 0 on success
+ */
+static int pcf85063a_emul_init(const struct emul *target, const struct device *parent)
+{
+	struct pcf85063a_emul_data *data = target->data;
+
+	ARG_UNUSED(parent);
+	memcpy(data->registers, reset_registers, RTC_REGISTER_SIZE);
+	data->int_asserted = true;
+	update_int(target, false);
+
+	return 0;
+}
+
+#define PCF85063A_EMUL(inst)                                                                       \
+	static const struct pcf85063a_emul_config pcf85063a_emul_config_##inst = {                \
+		.int_gpio = GPIO_DT_SPEC_INST_GET_OR(inst, int_gpios, {0}),                        \
+	};                                                                                         \
+	static struct pcf85063a_emul_data pcf85063a_emul_data_##inst;                              \
+	EMUL_DT_INST_DEFINE(inst, pcf85063a_emul_init, &pcf85063a_emul_data_##inst,                \
+			    &pcf85063a_emul_config_##inst, &pcf85063a_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(PCF85063A_EMUL)
@@ -0,0 +1,11 @@
+#ifndef PCF85063A_EMUL_H
+#define PCF85063A_EMUL_H
+
+#include <zephyr/drivers/emul.h>
+
+int pcf85063a_emul_advance(const struct emul *target, uint32_t ms);
+void pcf85063a_emul_get_registers(const struct emul *target, uint8_t *registers);
+void pcf85063a_emul_set_registers(const struct emul *target, const uint8_t *registers);
+void pcf85063a_emul_fail_transfers(const struct emul *target, uint32_t count, int error);
+
+#endif
@@ -0,0 +1,524 @@
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include "PCF85063A.h"
+#include "PCF85063A_journal.h"
+
+#ifdef CONFIG_FCB
+#include <zephyr/storage/flash_map.h>
+#endif
+#ifdef CONFIG_FILE_SYSTEM
+#include <zephyr/fs/fs.h>
+#endif
+
+LOG_MODULE_REGISTER(pcf85063a_journal, CONFIG_PCF85063A_LOG_LEVEL);
+
+/*
+ * Event journal stamped with RTC wall time. Producers only claim a slot of a
+ * bounded multi-producer ring and stamp it with the uptime, so logging takes
+ * no lock and never touches the bus, also from an ISR. The consumer drains the
+ * ring in the system work queue, converts uptimes to wall time through an
+ * anchor read from the RTC once per RTC_JOURNAL_ANCHOR_INTERVAL_MS and encodes
+ * the events as small deltas into batches for the sink.
+ *
+ * Each slot carries a sequence number: it equals the slot's ring position
+ * while the slot is free, position + 1 once a producer published it and
+ * position + RTC_JOURNAL_CAPACITY after the consumer took it.
+ */
+
+BUILD_ASSERT(IS_POWER_OF_TWO(RTC_JOURNAL_CAPACITY), "RTC_JOURNAL_CAPACITY must be a power of two");
+BUILD_ASSERT(RTC_JOURNAL_PAYLOAD_MAX < RTC_JOURNAL_ANCHOR_TAG,
+	     "Payload size collides with the anchor tag");
+
+#define RING_MASK (RTC_JOURNAL_CAPACITY - 1)
+
+// Largest LEB128 encoding of a 64-bit value
+#define VARINT_MAX_SIZE 10
+// Header, event id, delta and payload
+#define RECORD_MAX_SIZE (1 + 3 + 5 + RTC_JOURNAL_PAYLOAD_MAX)
+
+BUILD_ASSERT(RTC_JOURNAL_BATCH_SIZE >= 1 + VARINT_MAX_SIZE + RECORD_MAX_SIZE,
+	     "RTC_JOURNAL_BATCH_SIZE cannot hold an anchor and one event");
+
+struct journal_slot {
+	atomic_t sequence;
+	uint32_t uptime_ms;
+	uint16_t event_id;
+	uint8_t size;
+	uint8_t payload[RTC_JOURNAL_PAYLOAD_MAX];
+};
+
+static void journal_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(journal_work, journal_work_handler);
+
+static struct {
+	const struct device *dev;
+	struct pcf85063a_journal_sink *sink;
+	atomic_t head; // Next position claimed by a producer
+	atomic_t tail; // Next position taken by the consumer
+	atomic_t dropped;
+	struct journal_slot slots[RTC_JOURNAL_CAPACITY];
+
+	// Consumer state, guarded by lock
+	struct k_mutex lock;
+	bool anchor_valid;
+	int64_t anchor_epoch_ms;
+	uint32_t anchor_uptime_ms;
+	uint8_t batch[RTC_JOURNAL_BATCH_SIZE];
+} journal;
+
+/**
+ * @brief Uptime the events are stamped with, it keeps counting through deep sleeps
+ */
+static inline uint32_t journal_uptime_ms(void)
+{
+	return (uint32_t)pcf85063a_uptime_ms(journal.dev);
+}
+
+/**
+ * @brief Appends a LEB128 varint
+ *
+ * @param buffer Output with room for VARINT_MAX_SIZE bytes
+ * @param value Value to encode
+ * @return size_t Number of bytes written
+ */
+static size_t varint_put(uint8_t *buffer, uint64_t value)
+{
+	size_t size = 0;
+
+	while (value >= 0x80) {
+		buffer[size++] = (uint8_t)value | 0x80;
+		value >>= 7;
+	}
+	buffer[size++] = (uint8_t)value;
+
+	return size;
+}
+
+/**
+ * @brief Reads a LEB128 varint
+ *
+ * @param buffer Encoded data
+ * @param size Size of buffer in bytes
+ * @param offset Position to read from, advanced past the varint
+ * @param value Decoded value
+ * @return true if a complete varint of at most 64 bits was read
+ */
+static bool varint_get(const uint8_t *buffer, size_t size, size_t *offset, uint64_t *value)
+{
+	*value = 0;
+	for (unsigned int shift = 0; shift < 64 && *offset < size; shift += 7) {
+		const uint8_t byte = buffer[(*offset)++];
+
+		*value |= (uint64_t)(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Zigzag maps small negative deltas to small unsigned values: 0, -1, 1, -2, ...
+static inline uint32_t zigzag_encode(int32_t value)
+{
+	return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static inline int32_t zigzag_decode(uint32_t value)
+{
+	return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+/**
+ * @brief Encodes one event record
+ *
+ * @param record Output with room for RECORD_MAX_SIZE bytes
+ * @param slot Published slot holding the event
+ * @param previous_ms Uptime of the previous record in the batch
+ * @return size_t Size of the record in bytes
+ */
+static size_t journal_encode(uint8_t *record, const struct journal_slot *slot, uint32_t previous_ms)
+{
+	size_t size = 0;
+
+	record[size++] = slot->size;
+	size += varint_put(&record[size], slot->event_id);
+	size += varint_put(&record[size], zigzag_encode((int32_t)(slot->uptime_ms - previous_ms)));
+	memcpy(&record[size], slot->payload, slot->size);
+
+	return size + slot->size;
+}
+
+/**
+ * @brief Starts a batch with the anchor, refreshing it from the RTC when it is stale
+ *
+ * @return size_t Size of the anchor record, 0 if no anchor could be read
+ * @note Called with journal.lock held.
+ */
+static size_t journal_start_batch(void)
+{
+	const uint32_t now = journal_uptime_ms();
+
+	if (!journal.anchor_valid || now - journal.anchor_uptime_ms >= RTC_JOURNAL_ANCHOR_INTERVAL_MS) {
+		int64_t epoch_ms;
+
+		if (pcf85063a_fast_now(journal.dev, &epoch_ms) == RTC_SUCCESS) {
+			journal.anchor_epoch_ms = epoch_ms;
+			journal.anchor_uptime_ms = journal_uptime_ms();
+			journal.anchor_valid = true;
+		} else if (!journal.anchor_valid) {
+			LOG_ERR("Failed to read the journal anchor from the RTC \n");
+			return 0;
+		} else {
+			LOG_WRN("Failed to refresh the journal anchor, keeping the previous one \n");
+		}
+	}
+
+	journal.batch[0] = RTC_JOURNAL_ANCHOR_TAG;
+	return 1 + varint_put(&journal.batch[1], journal.anchor_epoch_ms);
+}
+
+/**
+ * @brief Hands the current batch to the sink
+ *
+ * @param size Size of the batch in bytes
+ * @return rtc_error_t RTC_ERROR_DEVICE_SETUP if the sink failed, the batch is lost then
+ */
+static rtc_error_t journal_write_batch(size_t size)
+{
+	int ret = journal.sink->write(journal.sink, journal.batch, size);
+	if (ret < 0) {
+		LOG_ERR("Error %d: journal sink dropped a batch of %u bytes \n", ret, (unsigned int)size);
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Drains every published event into batches
+ *
+ * Stops at the first slot that is claimed but not yet published, the next
+ * flush picks it up.
+ *
+ * @return rtc_error_t Status of the anchor read and the sink
+ */
+static rtc_error_t journal_drain(void)
+{
+	uint8_t record[RECORD_MAX_SIZE];
+	rtc_error_t status = RTC_SUCCESS;
+	uint32_t previous_ms = 0;
+	size_t size = 0;
+
+	k_mutex_lock(&journal.lock, K_FOREVER);
+
+	for (;;) {
+		const uint32_t tail = (uint32_t)atomic_get(&journal.tail);
+		struct journal_slot *slot = &journal.slots[tail & RING_MASK];
+
+		if ((uint32_t)atomic_get(&slot->sequence) != tail + 1) {
+			break;
+		}
+
+		if (size == 0) {
+			size = journal_start_batch();
+			if (size == 0) {
+				status = RTC_ERROR_I2C_READ;
+				break;
+			}
+			previous_ms = journal.anchor_uptime_ms;
+		}
+
+		const size_t record_size = journal_encode(record, slot, previous_ms);
+		if (size + record_size > sizeof(journal.batch)) {
+			// Full, the event opens the next batch with its own anchor
+			if (journal_write_batch(size) != RTC_SUCCESS) {
+				status = RTC_ERROR_DEVICE_SETUP;
+			}
+			size = 0;
+			continue;
+		}
+
+		memcpy(&journal.batch[size], record, record_size);
+		size += record_size;
+		previous_ms = slot->uptime_ms;
+
+		// Hand the slot back to producers one lap ahead
+		atomic_set(&slot->sequence, tail + RTC_JOURNAL_CAPACITY);
+		atomic_set(&journal.tail, tail + 1);
+	}
+
+	if (size > 0 && journal_write_batch(size) != RTC_SUCCESS) {
+		status = RTC_ERROR_DEVICE_SETUP;
+	}
+
+	k_mutex_unlock(&journal.lock);
+
+	return status;
+}
+
+static void journal_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)journal_drain();
+}
+
+/**
+ * @brief Starts the journal
+ *
+ * @param dev Pointer to the RTC device the anchors are read from
+ * @param sink Where encoded batches are stored
+ * @return rtc_error_t RTC_SUCCESS or RTC_ERROR_INVALID_PARAMETER
+ * @note Events logged before this are dropped.
+ */
+rtc_error_t pcf85063a_journal_init(const struct device *dev, struct pcf85063a_journal_sink *sink)
+{
+	if (dev == NULL || sink == NULL || sink->write == NULL) {
+		LOG_ERR("Journal device or sink was null \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	k_mutex_init(&journal.lock);
+	for (uint32_t i = 0; i < RTC_JOURNAL_CAPACITY; i++) {
+		atomic_set(&journal.slots[i].sequence, i);
+	}
+	atomic_set(&journal.head, 0);
+	atomic_set(&journal.tail, 0);
+	atomic_set(&journal.dropped, 0);
+	journal.anchor_valid = false;
+	journal.dev = dev;
+
+	// Producers check the sink to see whether the journal is running
+	compiler_barrier();
+	journal.sink = sink;
+
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Records an event stamped with the current time
+ *
+ * Copies the event into the ring and returns, the bus is only used later by
+ * the flush. Callable from any context, including ISRs.
+ *
+ * @param event_id Application defined event id
+ * @param payload Event data, may be NULL if size is 0
+ * @param size Size of payload, at most RTC_JOURNAL_PAYLOAD_MAX
+ * @return rtc_error_t RTC_ERROR_DEVICE_SETUP if the journal is not started or
+ *         full, RTC_ERROR_INVALID_PARAMETER for an oversized payload
+ */
+rtc_error_t pcf85063a_journal_log(uint16_t event_id, const void *payload, uint8_t size)
+{
+	if (size > RTC_JOURNAL_PAYLOAD_MAX || (payload == NULL && size > 0)) {
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+	if (journal.sink == NULL) {
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	const uint32_t uptime_ms = journal_uptime_ms();
+	uint32_t position = (uint32_t)atomic_get(&journal.head);
+	struct journal_slot *slot;
+
+	for (;;) {
+		slot = &journal.slots[position & RING_MASK];
+		const int32_t lag = (int32_t)((uint32_t)atomic_get(&slot->sequence) - position);
+
+		if (lag == 0) {
+			if (atomic_cas(&journal.head, position, position + 1)) {
+				break;
+			}
+		} else if (lag < 0) {
+			// The slot still holds an event from the previous lap
+			atomic_inc(&journal.dropped);
+			return RTC_ERROR_DEVICE_SETUP;
+		}
+		position = (uint32_t)atomic_get(&journal.head);
+	}
+
+	slot->uptime_ms = uptime_ms;
+	slot->event_id = event_id;
+	slot->size = size;
+	if (size > 0) {
+		memcpy(slot->payload, payload, size);
+	}
+	atomic_set(&slot->sequence, position + 1);
+
+	// Flush at the threshold, otherwise no later than one interval after the first event
+	const uint32_t waiting = position + 1 - (uint32_t)atomic_get(&journal.tail);
+	if (waiting >= RTC_JOURNAL_FLUSH_THRESHOLD) {
+		(void)k_work_reschedule(&journal_work, K_NO_WAIT);
+	} else {
+		(void)k_work_schedule(&journal_work, K_MSEC(RTC_JOURNAL_FLUSH_INTERVAL_MS));
+	}
+
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Writes every logged event to the sink now
+ *
+ * @return rtc_error_t RTC_ERROR_DEVICE_SETUP if the journal is not started or
+ *         the sink failed, RTC_ERROR_I2C_READ if no anchor could be read
+ * @note Sleeps, call it from a thread, e.g. before a reset.
+ */
+rtc_error_t pcf85063a_journal_flush(void)
+{
+	if (journal.sink == NULL) {
+		LOG_ERR("Journal was not started \n");
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	(void)k_work_cancel_delayable(&journal_work);
+	return journal_drain();
+}
+
+/**
+ * @brief Returns the number of events dropped because the ring was full
+ */
+uint32_t pcf85063a_journal_dropped(void)
+{
+	return (uint32_t)atomic_get(&journal.dropped);
+}
+
+/**
+ * @brief Decodes one batch written by the journal
+ *
+ * @param batch Batch as passed to the sink
+ * @param size Size of batch in bytes
+ * @param handler Called for every event in order
+ * @param user_data Passed to handler
+ * @return rtc_error_t RTC_ERROR_INVALID_PARAMETER if the batch is malformed,
+ *         events before the damage have been passed to handler
+ */
+rtc_error_t pcf85063a_journal_decode(const uint8_t *batch, size_t size,
+				     pcf85063a_journal_event_t handler, void *user_data)
+{
+	bool anchored = false;
+	int64_t time_ms = 0;
+	size_t offset = 0;
+	uint64_t value;
+
+	if (batch == NULL || handler == NULL) {
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	while (offset < size) {
+		const uint8_t header = batch[offset++];
+
+		if (header == RTC_JOURNAL_ANCHOR_TAG) {
+			if (!varint_get(batch, size, &offset, &value)) {
+				return RTC_ERROR_INVALID_PARAMETER;
+			}
+			time_ms = (int64_t)value;
+			anchored = true;
+			continue;
+		}
+		if (!anchored || header > RTC_JOURNAL_PAYLOAD_MAX) {
+			return RTC_ERROR_INVALID_PARAMETER;
+		}
+
+		if (!varint_get(batch, size, &offset, &value) || value > UINT16_MAX) {
+			return RTC_ERROR_INVALID_PARAMETER;
+		}
+		const uint16_t event_id = (uint16_t)value;
+
+		if (!varint_get(batch, size, &offset, &value) || value > UINT32_MAX ||
+		    size - offset < header) {
+			return RTC_ERROR_INVALID_PARAMETER;
+		}
+		time_ms += zigzag_decode((uint32_t)value);
+
+		handler(event_id, time_ms, &batch[offset], header, user_data);
+		offset += header;
+	}
+
+	return RTC_SUCCESS;
+}
+
+#ifdef CONFIG_FCB
+static int fcb_sink_write(struct pcf85063a_journal_sink *sink, const uint8_t *batch, size_t size)
+{
+	struct pcf85063a_journal_fcb_sink *fcb_sink =
+		CONTAINER_OF(sink, struct pcf85063a_journal_fcb_sink, sink);
+	struct fcb *fcb = fcb_sink->fcb;
+	struct fcb_entry loc;
+
+	int ret = fcb_append(fcb, size, &loc);
+	if (ret == -ENOSPC) {
+		// Full, give up the oldest sector
+		ret = fcb_rotate(fcb);
+		if (ret == 0) {
+			ret = fcb_append(fcb, size, &loc);
+		}
+	}
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = flash_area_write(fcb->fap, FCB_ENTRY_FA_DATA_OFF(loc), batch, size);
+	if (ret != 0) {
+		return ret;
+	}
+
+	return fcb_append_finish(fcb, &loc);
+}
+
+/**
+ * @brief Sets up a sink that appends each batch as one entry of an initialized FCB
+ *
+ * @param fcb_sink Sink to set up
+ * @param fcb Flash circular buffer, already set up with fcb_init()
+ */
+void pcf85063a_journal_fcb_sink_init(struct pcf85063a_journal_fcb_sink *fcb_sink, struct fcb *fcb)
+{
+	fcb_sink->sink.write = fcb_sink_write;
+	fcb_sink->fcb = fcb;
+}
+#endif
+
+#ifdef CONFIG_FILE_SYSTEM
+static int file_sink_write(struct pcf85063a_journal_sink *sink, const uint8_t *batch, size_t size)
+{
+	struct pcf85063a_journal_file_sink *file_sink =
+		CONTAINER_OF(sink, struct pcf85063a_journal_file_sink, sink);
+	struct fs_file_t file;
+
+	fs_file_t_init(&file);
+	int ret = fs_open(&file, file_sink->path, FS_O_CREATE | FS_O_WRITE | FS_O_APPEND);
+	if (ret < 0) {
+		return ret;
+	}
+
+	const ssize_t written = fs_write(&file, batch, size);
+	ret = fs_close(&file);
+	if (written < 0) {
+		return (int)written;
+	}
+	if ((size_t)written != size) {
+		return -ENOSPC;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Sets up a sink that appends each batch to a file
+ *
+ * @param file_sink Sink to set up
+ * @param path File to append to, created if missing
+ * @note Batches are stored back to back. Each starts with RTC_JOURNAL_ANCHOR_TAG,
+ *       so a reader can decode the whole file as one batch.
+ */
+void pcf85063a_journal_file_sink_init(struct pcf85063a_journal_file_sink *file_sink,
+				      const char *path)
+{
+	file_sink->sink.write = file_sink_write;
+	file_sink->path = path;
+}
+#endif
@@ -0,0 +1,93 @@
+#ifndef PCF85063A_JOURNAL_H
+#define PCF85063A_JOURNAL_H
+
+#include <zephyr/device.h>
+#include "PCF85063A.h"
+
+// Events held between flushes, a power of two. Events logged while it is full are dropped.
+#define RTC_JOURNAL_CAPACITY 64
+// Largest event payload in bytes
+#define RTC_JOURNAL_PAYLOAD_MAX 12
+// A flush is queued once this many events are waiting, and at least every
+// RTC_JOURNAL_FLUSH_INTERVAL_MS while any are
+#define RTC_JOURNAL_FLUSH_THRESHOLD 32
+#define RTC_JOURNAL_FLUSH_INTERVAL_MS 5000
+// Size of one batch handed to the sink
+#define RTC_JOURNAL_BATCH_SIZE 256
+// The wall time of the anchor is refreshed from the RTC after this long
+#define RTC_JOURNAL_ANCHOR_INTERVAL_MS 60000
+
+/*
+ * Batch format. Every batch starts with an anchor record, so each one can be
+ * decoded on its own:
+ *
+ *   anchor: 0x80, varint wall time in ms since the Unix epoch
+ *   event:  payload size (0-RTC_JOURNAL_PAYLOAD_MAX), varint event id,
+ *           zigzag varint ms since the previous record, payload
+ *
+ * The first event of a batch is relative to the anchor. Varints are LEB128,
+ * 7 bits per byte, least significant group first.
+ */
+#define RTC_JOURNAL_ANCHOR_TAG 0x80
+
+struct pcf85063a_journal_sink;
+
+/**
+ * @brief Stores one encoded batch
+ *
+ * @param sink The sink
+ * @param batch Encoded records
+ * @param size Size of batch in bytes
+ * @return int 0 on success, negative errno otherwise; the batch is lost then
+ * @note Called from the system work queue or from pcf85063a_journal_flush().
+ */
+typedef int (*pcf85063a_journal_write_t)(struct pcf85063a_journal_sink *sink, const uint8_t *batch,
+					 size_t size);
+
+struct pcf85063a_journal_sink {
+	pcf85063a_journal_write_t write;
+};
+
+#ifdef CONFIG_FCB
+#include <zephyr/fs/fcb.h>
+
+// Stores each batch as one entry of a flash circular buffer, rotating out the oldest when full
+struct pcf85063a_journal_fcb_sink {
+	struct pcf85063a_journal_sink sink;
+	struct fcb *fcb;
+};
+
+void pcf85063a_journal_fcb_sink_init(struct pcf85063a_journal_fcb_sink *fcb_sink, struct fcb *fcb);
+#endif
+
+#ifdef CONFIG_FILE_SYSTEM
+// Appends each batch to a file, e.g. on the native_sim host file system
+struct pcf85063a_journal_file_sink {
+	struct pcf85063a_journal_sink sink;
+	const char *path;
+};
+
+void pcf85063a_journal_file_sink_init(struct pcf85063a_journal_file_sink *file_sink,
+				      const char *path);
+#endif
+
+/**
+ * @brief Called by pcf85063a_journal_decode() for every event of a batch
+ *
+ * @param event_id Id passed to pcf85063a_journal_log()
+ * @param epoch_ms Wall time of the event in ms since the Unix epoch
+ * @param payload Event payload
+ * @param size Size of the payload in bytes
+ * @param user_data Pointer passed to pcf85063a_journal_decode()
+ */
+typedef void (*pcf85063a_journal_event_t)(uint16_t event_id, int64_t epoch_ms,
+					  const uint8_t *payload, uint8_t size, void *user_data);
+
+rtc_error_t pcf85063a_journal_init(const struct device *dev, struct pcf85063a_journal_sink *sink);
+rtc_error_t pcf85063a_journal_log(uint16_t event_id, const void *payload, uint8_t size);
+rtc_error_t pcf85063a_journal_flush(void);
+uint32_t pcf85063a_journal_dropped(void);
+rtc_error_t pcf85063a_journal_decode(const uint8_t *batch, size_t size,
+				     pcf85063a_journal_event_t handler, void *user_data);
+
+#endif
@@ -0,0 +1,276 @@
+#include <string.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/stats/stats.h>
+#include "PCF85063A_stats.h"
+
+/*
+ * Driver-wide bus and interrupt statistics. Every record lands in a
+ * per-operation struct under a spinlock, since async completions can run in
+ * interrupt context, and is mirrored into one Zephyr stats group per
+ * operation. The p99 in the groups is refreshed every STATS_P99_REFRESH
+ * records and whenever the stats are read.
+ */
+
+#define STATS_P99_REFRESH 32
+
+STATS_SECT_START(pcf85063a_op)
+STATS_SECT_ENTRY32(calls)
+STATS_SECT_ENTRY32(bytes)
+STATS_SECT_ENTRY32(errors)
+STATS_SECT_ENTRY32(lat_min_us)
+STATS_SECT_ENTRY32(lat_avg_us)
+STATS_SECT_ENTRY32(lat_max_us)
+STATS_SECT_ENTRY32(lat_p99_us)
+STATS_SECT_END;
+
+STATS_NAME_START(pcf85063a_op)
+STATS_NAME(pcf85063a_op, calls)
+STATS_NAME(pcf85063a_op, bytes)
+STATS_NAME(pcf85063a_op, errors)
+STATS_NAME(pcf85063a_op, lat_min_us)
+STATS_NAME(pcf85063a_op, lat_avg_us)
+STATS_NAME(pcf85063a_op, lat_max_us)
+STATS_NAME(pcf85063a_op, lat_p99_us)
+STATS_NAME_END(pcf85063a_op);
+
+static STATS_SECT_DECL(pcf85063a_op) op_groups[PCF85063A_STATS_OP_COUNT];
+static const char *const op_names[PCF85063A_STATS_OP_COUNT] = {
+	[PCF85063A_STATS_READ] = "pcf85063a_read",
+	[PCF85063A_STATS_WRITE] = "pcf85063a_write",
+	[PCF85063A_STATS_INT] = "pcf85063a_int",
+};
+
+static struct pcf85063a_op_stats op_stats[PCF85063A_STATS_OP_COUNT];
+static struct k_spinlock stats_lock;
+
+/**
+ * @brief Maps a latency to its histogram bucket
+ *
+ * Latencies below 4 cycles get a bucket each, above that every power of two
+ * is split into 4 buckets by the two bits below the leading one.
+ *
+ * @param cycles Latency in CPU cycles
+ * @return uint32_t Bucket index, below RTC_STATS_LATENCY_BUCKETS
+ */
+static inline uint32_t latency_bucket(uint32_t cycles)
+{
+	if (cycles < 4) {
+		return cycles;
+	}
+
+	const uint32_t msb = 31 - __builtin_clz(cycles);
+	return (msb - 1) * 4 + ((cycles >> (msb - 2)) & 3);
+}
+
+/**
+ * @brief Returns the largest latency that falls into a bucket
+ *
+ * @param bucket Bucket index
+ * @return uint32_t Upper bound of the bucket in CPU cycles
+ */
+static inline uint32_t latency_bucket_max(uint32_t bucket)
+{
+	if (bucket < 4) {
+		return bucket;
+	}
+
+	const uint32_t shift = bucket / 4 - 1;
+	return (((4 + bucket % 4 + 1) << shift) - 1);
+}
+
+/**
+ * @brief Copies one operation's stats into its Zephyr stats group
+ *
+ * @param op Operation to mirror
+ * @param refresh_p99 True to recompute the p99 from the histogram
+ */
+static void stats_group_update(enum pcf85063a_stats_op op, bool refresh_p99)
+{
+	const struct pcf85063a_op_stats *stats = &op_stats[op];
+	const uint32_t completed = stats->calls;
+
+	STATS_SET(op_groups[op], calls, stats->calls);
+	STATS_SET(op_groups[op], bytes, stats->bytes);
+	STATS_SET(op_groups[op], errors, stats->errors);
+
+	if (completed == 0) {
+		STATS_SET(op_groups[op], lat_min_us, 0);
+		STATS_SET(op_groups[op], lat_avg_us, 0);
+		STATS_SET(op_groups[op], lat_max_us, 0);
+		STATS_SET(op_groups[op], lat_p99_us, 0);
+		return;
+	}
+
+	STATS_SET(op_groups[op], lat_min_us, k_cyc_to_us_near32(stats->min_cycles));
+	STATS_SET(op_groups[op], lat_avg_us,
+		  k_cyc_to_us_near32(stats->total_cycles / completed));
+	STATS_SET(op_groups[op], lat_max_us, k_cyc_to_us_near32(stats->max_cycles));
+	if (refresh_p99) {
+		STATS_SET(op_groups[op], lat_p99_us,
+			  k_cyc_to_us_near32(pcf85063a_stats_percentile(stats, 99)));
+	}
+}
+
+/**
+ * @brief Records one completed operation
+ *
+ * @param op Kind of operation
+ * @param bytes Register bytes moved over the bus
+ * @param err 0 on success, negative errno from the bus otherwise
+ * @param cycles Duration in CPU cycles
+ * @note Safe to call from interrupt context.
+ */
+void pcf85063a_stats_record(enum pcf85063a_stats_op op, size_t bytes, int err, uint32_t cycles)
+{
+	struct pcf85063a_op_stats *stats = &op_stats[op];
+
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	stats->calls++;
+	stats->total_cycles += cycles;
+	stats->min_cycles = stats->calls == 1 ? cycles : MIN(stats->min_cycles, cycles);
+	stats->max_cycles = MAX(stats->max_cycles, cycles);
+	stats->latency_buckets[latency_bucket(cycles)]++;
+
+	if (err == 0) {
+		stats->bytes += bytes;
+	} else {
+		stats->errors++;
+
+		int slot = 0;
+		while (slot < RTC_STATS_ERRNO_SLOTS && stats->errno_counts[slot].count != 0 &&
+		       stats->errno_counts[slot].err != err) {
+			slot++;
+		}
+		if (slot < RTC_STATS_ERRNO_SLOTS) {
+			stats->errno_counts[slot].err = err;
+			stats->errno_counts[slot].count++;
+		} else {
+			stats->errors_other++;
+		}
+	}
+
+	stats_group_update(op, stats->calls % STATS_P99_REFRESH == 0);
+
+	k_spin_unlock(&stats_lock, key);
+}
+
+/**
+ * @brief Copies the stats of one operation
+ *
+ * @param op Kind of operation
+ * @param stats Pointer to store the stats
+ */
+void pcf85063a_stats_get(enum pcf85063a_stats_op op, struct pcf85063a_op_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+	*stats = op_stats[op];
+	stats_group_update(op, true);
+	k_spin_unlock(&stats_lock, key);
+}
+
+/**
+ * @brief Estimates a latency percentile from the histogram
+ *
+ * @param stats Stats of one operation
+ * @param percent Percentile to report, 1-100
+ * @return uint32_t Upper bound in CPU cycles of the bucket holding the percentile,
+ *         at most 25% above the true value
+ */
+uint32_t pcf85063a_stats_percentile(const struct pcf85063a_op_stats *stats, uint32_t percent)
+{
+	const uint64_t rank = ((uint64_t)stats->calls * percent + 99) / 100;
+	uint64_t seen = 0;
+
+	for (uint32_t bucket = 0; bucket < RTC_STATS_LATENCY_BUCKETS; bucket++) {
+		seen += stats->latency_buckets[bucket];
+		if (seen >= rank && seen > 0) {
+			return MIN(latency_bucket_max(bucket), stats->max_cycles);
+		}
+	}
+
+	return stats->max_cycles;
+}
+
+/**
+ * @brief Clears the stats of every operation
+ */
+void pcf85063a_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+	memset(op_stats, 0, sizeof(op_stats));
+	for (int op = 0; op < PCF85063A_STATS_OP_COUNT; op++) {
+		stats_group_update(op, true);
+	}
+	k_spin_unlock(&stats_lock, key);
+}
+
+/**
+ * @brief Registers the stats groups at boot
+ */
+static int pcf85063a_stats_init(void)
+{
+	for (int op = 0; op < PCF85063A_STATS_OP_COUNT; op++) {
+		int ret = stats_init_and_reg(STATS_HDR(op_groups[op]),
+					     STATS_SIZE_INIT_PARMS(op_groups[op], STATS_SIZE_32),
+					     STATS_NAME_INIT_PARMS(pcf85063a_op), op_names[op]);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+SYS_INIT(pcf85063a_stats_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#ifdef CONFIG_PCF85063A_STATS_SHELL
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	struct pcf85063a_op_stats stats;
+
+	for (int op = 0; op < PCF85063A_STATS_OP_COUNT; op++) {
+		pcf85063a_stats_get(op, &stats);
+
+		shell_print(sh, "%s: calls %u, bytes %u, errors %u", op_names[op], stats.calls,
+			    stats.bytes, stats.errors);
+		for (int slot = 0; slot < RTC_STATS_ERRNO_SLOTS && stats.errno_counts[slot].count;
+		     slot++) {
+			shell_print(sh, "  errno %d: %u", stats.errno_counts[slot].err,
+				    stats.errno_counts[slot].count);
+		}
+		if (stats.errors_other != 0) {
+			shell_print(sh, "  other errno: %u", stats.errors_other);
+		}
+		if (stats.calls != 0) {
+			shell_print(sh, "  latency us: min %u, avg %u, max %u, p99 %u",
+				    k_cyc_to_us_near32(stats.min_cycles),
+				    k_cyc_to_us_near32(stats.total_cycles / stats.calls),
+				    k_cyc_to_us_near32(stats.max_cycles),
+				    k_cyc_to_us_near32(pcf85063a_stats_percentile(&stats, 99)));
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	pcf85063a_stats_reset();
+	shell_print(sh, "Statistics reset");
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_pcf85063a_stats,
+			       SHELL_CMD(reset, NULL, "Reset driver statistics", cmd_stats_reset),
+			       SHELL_SUBCMD_SET_END);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_pcf85063a,
+			       SHELL_CMD(stats, &sub_pcf85063a_stats, "Show driver statistics",
+					 cmd_stats),
+			       SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(pcf85063a, &sub_pcf85063a, "PCF85063A RTC commands", NULL);
+#endif /* CONFIG_PCF85063A_STATS_SHELL */
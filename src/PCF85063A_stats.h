@@ -0,0 +1,46 @@
+#ifndef PCF85063A_STATS_H
+#define PCF85063A_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Latency histogram: 4 buckets per power of two of CPU cycles
+#define RTC_STATS_LATENCY_BUCKETS 124
+// Distinct errno values counted per operation, further ones go to errors_other
+#define RTC_STATS_ERRNO_SLOTS 4
+
+enum pcf85063a_stats_op {
+	PCF85063A_STATS_READ,
+	PCF85063A_STATS_WRITE,
+	PCF85063A_STATS_INT,
+	PCF85063A_STATS_OP_COUNT,
+};
+
+struct pcf85063a_op_stats {
+	uint32_t calls;
+	uint32_t bytes;
+	uint32_t errors;
+	struct {
+		int err;
+		uint32_t count;
+	} errno_counts[RTC_STATS_ERRNO_SLOTS];
+	uint32_t errors_other;
+	uint32_t min_cycles;
+	uint32_t max_cycles;
+	uint64_t total_cycles;
+	uint32_t latency_buckets[RTC_STATS_LATENCY_BUCKETS];
+};
+
+#ifdef CONFIG_PCF85063A_STATS
+void pcf85063a_stats_record(enum pcf85063a_stats_op op, size_t bytes, int err, uint32_t cycles);
+void pcf85063a_stats_get(enum pcf85063a_stats_op op, struct pcf85063a_op_stats *stats);
+uint32_t pcf85063a_stats_percentile(const struct pcf85063a_op_stats *stats, uint32_t percent);
+void pcf85063a_stats_reset(void);
+#else
+static inline void pcf85063a_stats_record(enum pcf85063a_stats_op op, size_t bytes, int err,
+					  uint32_t cycles)
+{
+}
+#endif
+
+#endif
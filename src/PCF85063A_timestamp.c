@@ -0,0 +1,291 @@
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+#include "PCF85063A.h"
+#include "PCF85063A_timestamp.h"
+
+LOG_MODULE_REGISTER(pcf85063a_timestamp, CONFIG_PCF85063A_LOG_LEVEL);
+
+/*
+ * Microsecond wall clock built from the RTC seconds and the CPU cycle counter.
+ * Readers only evaluate base_us + (cycles - base_cycles) * slew_mult under a
+ * spinlock, so they never touch the bus. A work item measures the cycle count
+ * of an RTC second edge every RTC_TIMESTAMP_RESYNC_MS, estimates the real CPU
+ * clock rate from consecutive edges and bends the line towards the RTC
+ * instead of jumping to it.
+ *
+ * The state is a single instance, so the service runs on one RTC at a time.
+ */
+
+// Rates are microseconds per cycle in 32.32 fixed point
+#define RATE_SHIFT 32
+
+static void timestamp_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(timestamp_work, timestamp_work_handler);
+
+static struct {
+	const struct device *dev;
+	struct k_spinlock lock;
+
+	// Line evaluated by readers, guarded by lock
+	bool synced;
+	int64_t base_us;
+	uint64_t base_cycles;
+	uint64_t slew_mult;
+	int64_t last_us;
+
+	// Last measured second edge and the CPU clock rate derived from it
+	bool edge_valid;
+	int64_t edge_seconds;
+	uint64_t edge_cycles;
+	uint64_t nominal_mult;
+	uint64_t mult;
+	bool restart;
+
+	// Edge search state, only touched by the work handler
+	bool polling;
+	int64_t poll_seconds;
+	uint64_t poll_cycles;
+} ts;
+
+/**
+ * @brief Scales a cycle count by a 32.32 fixed point rate without overflowing
+ *
+ * @param cycles Number of CPU cycles
+ * @param mult Microseconds per cycle in 32.32 fixed point
+ * @return int64_t Microseconds
+ */
+static inline int64_t cycles_to_us(uint64_t cycles, uint64_t mult)
+{
+	const uint64_t low = cycles & UINT32_MAX;
+
+	return (cycles >> RATE_SHIFT) * mult + low * (mult >> RATE_SHIFT) +
+	       ((low * (mult & UINT32_MAX)) >> RATE_SHIFT);
+}
+
+/**
+ * @brief Folds a measured second edge into the clock rate and the reader line
+ *
+ * The first edge sets the line directly. Later edges refine the rate and move
+ * the line so that the remaining offset is worked off by the next resync,
+ * unless the offset exceeds RTC_TIMESTAMP_STEP_US. Readers hold at the last
+ * timestamp through a backward step of up to RTC_TIMESTAMP_MAX_FREEZE_US,
+ * larger backward steps take them back with it.
+ *
+ * @param seconds Seconds since the Unix epoch that started at the edge
+ * @param edge_cycles CPU cycle count at the edge
+ */
+static void timestamp_apply_edge(int64_t seconds, uint64_t edge_cycles)
+{
+	k_spinlock_key_t key = k_spin_lock(&ts.lock);
+
+	if (ts.edge_valid && seconds > ts.edge_seconds &&
+	    seconds - ts.edge_seconds <= RTC_TIMESTAMP_RESYNC_MS / MSEC_PER_SEC * 4) {
+		const uint64_t measured = ((uint64_t)(seconds - ts.edge_seconds) * USEC_PER_SEC
+					   << RATE_SHIFT) /
+					  (edge_cycles - ts.edge_cycles);
+		const int64_t error = (int64_t)(measured - ts.nominal_mult);
+		const int64_t limit = ts.nominal_mult * RTC_TIMESTAMP_MAX_RATE_PPM / USEC_PER_SEC;
+
+		// Edges carry up to one poll interval of jitter, so average over a few
+		if (error <= limit && error >= -limit) {
+			ts.mult += ((int64_t)(measured - ts.mult)) / 4;
+		}
+	}
+	ts.edge_valid = true;
+	ts.edge_seconds = seconds;
+	ts.edge_cycles = edge_cycles;
+
+	const uint64_t now = k_cycle_get_64();
+	const int64_t rtc_us = seconds * (int64_t)USEC_PER_SEC + cycles_to_us(now - edge_cycles, ts.mult);
+	const int64_t model_us = ts.base_us + cycles_to_us(now - ts.base_cycles, ts.slew_mult);
+	const int64_t offset_us = rtc_us - model_us;
+	bool stepped_back = false;
+
+	if (!ts.synced || offset_us > RTC_TIMESTAMP_STEP_US || offset_us < -RTC_TIMESTAMP_STEP_US) {
+		// Readers hold at last_us until a backwards step has been caught up,
+		// unless that would stop them for longer than RTC_TIMESTAMP_MAX_FREEZE_US
+		if (ts.last_us - rtc_us > RTC_TIMESTAMP_MAX_FREEZE_US) {
+			ts.last_us = rtc_us;
+			stepped_back = true;
+		}
+		ts.base_us = rtc_us;
+		ts.slew_mult = ts.mult;
+		ts.synced = true;
+	} else {
+		int64_t ppm = offset_us * (int64_t)MSEC_PER_SEC / RTC_TIMESTAMP_RESYNC_MS;
+
+		ppm = CLAMP(ppm, -RTC_TIMESTAMP_MAX_SLEW_PPM, RTC_TIMESTAMP_MAX_SLEW_PPM);
+		ts.base_us = model_us;
+		ts.slew_mult = ts.mult + (int64_t)ts.mult * ppm / (int64_t)USEC_PER_SEC;
+	}
+	ts.base_cycles = now;
+
+	k_spin_unlock(&ts.lock, key);
+
+	if (stepped_back) {
+		LOG_WRN("Timestamps stepped back by %lld us to the RTC \n", -offset_us);
+	}
+	LOG_DBG("Second edge %lld, offset %lld us \n", seconds, offset_us);
+}
+
+/**
+ * @brief Polls the seconds register until it changes and timestamps the edge
+ *
+ * Each read is stamped with the cycle count halfway through the transfer, and
+ * the edge is placed halfway between the last read of the old second and the
+ * first read of the new one.
+ */
+static void timestamp_work_handler(struct k_work *work)
+{
+	uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+
+	k_spinlock_key_t key = k_spin_lock(&ts.lock);
+	const struct device *dev = ts.dev;
+	if (ts.restart) {
+		ts.restart = false;
+		ts.polling = false;
+	}
+	k_spin_unlock(&ts.lock, key);
+
+	if (dev == NULL) {
+		return;
+	}
+
+	const uint64_t before = k_cycle_get_64();
+	rtc_error_t ret = pcf85063a_read_register(dev, time_block, sizeof(time_block),
+						  RTC_TIME_REGISTER_ADDRESS);
+	const uint64_t after = k_cycle_get_64();
+
+	if (ret != RTC_SUCCESS || (time_block[SECONDS_INDEX] & RTC_OSCILLATOR_STOPPED) ||
+	    !rtc_time_block_is_valid(time_block)) {
+		LOG_ERR("Error %d: no valid time for timestamp resync \n", ret);
+		ts.polling = false;
+		k_work_reschedule(&timestamp_work, K_MSEC(RTC_TIMESTAMP_RESYNC_MS));
+		return;
+	}
+
+	const int64_t seconds = rtc_time_block_to_epoch(time_block);
+	const uint64_t read_cycles = before + (after - before) / 2;
+
+	if (ts.polling && seconds == ts.poll_seconds + 1) {
+		timestamp_apply_edge(seconds, ts.poll_cycles + (read_cycles - ts.poll_cycles) / 2);
+		ts.polling = false;
+		k_work_reschedule(&timestamp_work,
+				  K_MSEC(RTC_TIMESTAMP_RESYNC_MS - RTC_TIMESTAMP_EDGE_GUARD_MS));
+		return;
+	}
+
+	// Still in the old second, or the window just opened
+	ts.polling = true;
+	ts.poll_seconds = seconds;
+	ts.poll_cycles = read_cycles;
+	k_work_reschedule(&timestamp_work, K_MSEC(RTC_TIMESTAMP_EDGE_POLL_MS));
+}
+
+/**
+ * @brief Starts the timestamp service on an RTC
+ *
+ * Timestamps become available after the first second edge has been measured,
+ * which takes up to one second of polling the seconds register every
+ * RTC_TIMESTAMP_EDGE_POLL_MS.
+ *
+ * @param dev Pointer to the RTC device
+ * @return rtc_error_t RTC_ERROR_DEVICE_SETUP if the device is not ready or the
+ *         service already runs on another RTC
+ * @note The service keeps one clock, so it runs on one RTC at a time. Stop it
+ *       before starting it on another one.
+ */
+rtc_error_t pcf85063a_timestamp_start(const struct device *dev)
+{
+	if (dev == NULL || !device_is_ready(dev)) {
+		LOG_ERR("RTC device not ready for timestamps \n");
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&ts.lock);
+	const struct device *running = ts.dev;
+	if (running != NULL && running != dev) {
+		k_spin_unlock(&ts.lock, key);
+		LOG_ERR("Timestamps already run on %s \n", running->name);
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+	ts.dev = dev;
+	ts.synced = false;
+	ts.edge_valid = false;
+	ts.restart = true;
+	ts.last_us = 0;
+	ts.nominal_mult = ((uint64_t)USEC_PER_SEC << RATE_SHIFT) / sys_clock_hw_cycles_per_sec();
+	ts.mult = ts.nominal_mult;
+	ts.slew_mult = ts.nominal_mult;
+	k_spin_unlock(&ts.lock, key);
+
+	k_work_reschedule(&timestamp_work, K_NO_WAIT);
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Stops the timestamp service, timestamps are unavailable until restarted
+ */
+void pcf85063a_timestamp_stop(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&ts.lock);
+	ts.dev = NULL;
+	ts.synced = false;
+	k_spin_unlock(&ts.lock, key);
+
+	k_work_cancel_delayable(&timestamp_work);
+}
+
+/**
+ * @brief Measures a new second edge right away
+ *
+ * @note Call after setting the time on the chip. The clock rate estimate
+ *       restarts, and timestamps step to the new time unless it is within
+ *       RTC_TIMESTAMP_STEP_US of the old one.
+ */
+void pcf85063a_timestamp_resync(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&ts.lock);
+	ts.edge_valid = false;
+	ts.restart = true;
+	k_spin_unlock(&ts.lock, key);
+
+	k_work_reschedule(&timestamp_work, K_NO_WAIT);
+}
+
+/**
+ * @brief Returns the wall time in microseconds without going to the bus
+ *
+ * Safe to call from any thread or ISR. Consecutive results never decrease
+ * across resyncs, unless the time on the chip was set back by more than
+ * RTC_TIMESTAMP_MAX_FREEZE_US.
+ *
+ * @param timestamp_us Pointer to store the microseconds since 1970-01-01 00:00:00
+ * @return rtc_error_t RTC_ERROR_DEVICE_SETUP until the first second edge has been measured
+ */
+rtc_error_t pcf85063a_timestamp_us(int64_t *timestamp_us)
+{
+	if (timestamp_us == NULL) {
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&ts.lock);
+
+	if (!ts.synced) {
+		k_spin_unlock(&ts.lock, key);
+		return RTC_ERROR_DEVICE_SETUP;
+	}
+
+	int64_t now = ts.base_us + cycles_to_us(k_cycle_get_64() - ts.base_cycles, ts.slew_mult);
+	if (now < ts.last_us) {
+		now = ts.last_us;
+	} else {
+		ts.last_us = now;
+	}
+
+	k_spin_unlock(&ts.lock, key);
+
+	*timestamp_us = now;
+	return RTC_SUCCESS;
+}
@@ -0,0 +1,31 @@
+#ifndef PCF85063A_TIMESTAMP_H
+#define PCF85063A_TIMESTAMP_H
+
+#include <zephyr/device.h>
+#include "PCF85063A.h"
+
+// The second edge is re-measured every RTC_TIMESTAMP_RESYNC_MS (a whole number of
+// seconds). Polling for it starts RTC_TIMESTAMP_EDGE_GUARD_MS before the expected
+// edge and repeats every RTC_TIMESTAMP_EDGE_POLL_MS.
+#define RTC_TIMESTAMP_RESYNC_MS 10000
+#define RTC_TIMESTAMP_EDGE_GUARD_MS 20
+#define RTC_TIMESTAMP_EDGE_POLL_MS 1
+
+// Offsets up to RTC_TIMESTAMP_STEP_US are slewed away over one resync interval at no
+// more than RTC_TIMESTAMP_MAX_SLEW_PPM, larger ones are stepped. Readers hold still
+// through a backward step of up to RTC_TIMESTAMP_MAX_FREEZE_US and follow a larger one
+// back, which means the time on the chip was set back.
+#define RTC_TIMESTAMP_MAX_SLEW_PPM 500
+#define RTC_TIMESTAMP_STEP_US 1000000
+#define RTC_TIMESTAMP_MAX_FREEZE_US 2000000
+
+// Measured CPU clock rates further than this from nominal are treated as a time set
+// on the chip and ignored
+#define RTC_TIMESTAMP_MAX_RATE_PPM 1000
+
+rtc_error_t pcf85063a_timestamp_start(const struct device *dev);
+void pcf85063a_timestamp_stop(void);
+void pcf85063a_timestamp_resync(void);
+rtc_error_t pcf85063a_timestamp_us(int64_t *timestamp_us);
+
+#endif
@@ -0,0 +1,104 @@
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include "PCF85063A.h"
+#include "PCF85063A_tz.h"
+#include "pcf85063a_tz_table.h"
+
+LOG_MODULE_REGISTER(pcf85063a_tz, CONFIG_PCF85063A_LOG_LEVEL);
+
+static const struct rtc_tz_table tz_table = {
+	.starts = pcf85063a_tz_starts,
+	.offsets = pcf85063a_tz_offsets,
+	.count = PCF85063A_TZ_TRANSITIONS,
+};
+
+// Interval of the last lookup. Nearly every lookup falls into the same one, so a
+// racing update only costs the loser a binary search.
+static atomic_t tz_hint;
+
+/**
+ * @brief Returns the IANA name of the compiled-in time zone
+ */
+const char *pcf85063a_tz_name(void)
+{
+	return PCF85063A_TZ_NAME;
+}
+
+/**
+ * @brief Returns the UTC offset of the local time zone at a UTC time
+ *
+ * @param utc_epoch Seconds since the Unix epoch, UTC
+ * @return int32_t Offset in seconds, local time is utc_epoch plus this
+ * @note Safe to call from ISRs, it never touches the bus.
+ */
+int32_t pcf85063a_tz_offset(int64_t utc_epoch)
+{
+	size_t hint = (size_t)atomic_get(&tz_hint);
+	const int32_t offset = rtc_tz_offset(&tz_table, utc_epoch, &hint);
+
+	atomic_set(&tz_hint, (atomic_val_t)hint);
+	return offset;
+}
+
+/**
+ * @brief Converts a UTC time to local time
+ *
+ * @param utc_epoch Seconds since the Unix epoch, UTC
+ * @return int64_t Local time in the same count, so that the epoch conversions
+ *         (rtc_epoch_to_time_block(), gmtime_r()) yield local calendar fields
+ */
+int64_t pcf85063a_tz_to_local(int64_t utc_epoch)
+{
+	return utc_epoch + pcf85063a_tz_offset(utc_epoch);
+}
+
+/**
+ * @brief Returns the local time in milliseconds without going to the bus on every call
+ *
+ * @param dev Pointer to the RTC device, which keeps UTC
+ * @param local_ms Pointer to store the local time in ms, counted like the Unix epoch
+ * @return rtc_error_t Status of pcf85063a_fast_now()
+ */
+rtc_error_t pcf85063a_local_now_ms(const struct device *dev, int64_t *local_ms)
+{
+	int64_t utc_ms;
+
+	if (local_ms == NULL) {
+		LOG_ERR("local_ms was null \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	rtc_error_t ret = pcf85063a_fast_now(dev, &utc_ms);
+	if (ret != RTC_SUCCESS) {
+		return ret;
+	}
+
+	*local_ms = utc_ms + (int64_t)pcf85063a_tz_offset(utc_ms / MSEC_PER_SEC) * MSEC_PER_SEC;
+	return RTC_SUCCESS;
+}
+
+/**
+ * @brief Reads the RTC and returns the local time as a BCD time block
+ *
+ * @param dev Pointer to the RTC device, which keeps UTC
+ * @param time_block Pointer to the 7 BCD time registers to fill with local time
+ * @return rtc_error_t Read status code, RTC_ERROR_INVALID_PARAMETER if the
+ *         local time falls outside 2000-2099
+ */
+rtc_error_t pcf85063a_local_time_block(const struct device *dev, uint8_t *time_block)
+{
+	int64_t utc_epoch;
+
+	if (time_block == NULL) {
+		LOG_ERR("time_block was null \n");
+		return RTC_ERROR_INVALID_PARAMETER;
+	}
+
+	rtc_error_t ret = pcf85063a_get_epoch(dev, &utc_epoch);
+	if (ret != RTC_SUCCESS) {
+		return ret;
+	}
+
+	return rtc_epoch_to_time_block(pcf85063a_tz_to_local(utc_epoch), time_block);
+}
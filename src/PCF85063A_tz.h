@@ -0,0 +1,19 @@
+#ifndef PCF85063A_TZ_H
+#define PCF85063A_TZ_H
+
+#include <zephyr/device.h>
+#include "PCF85063A.h"
+
+/*
+ * Local time view of the UTC the chip keeps. The UTC offsets of
+ * CONFIG_PCF85063A_TZ_NAME for 2000-2099 are compiled in as a transition table
+ * by cmake/pcf85063a_tz_table.py, so no DST rules are evaluated at run time.
+ */
+
+const char *pcf85063a_tz_name(void);
+int32_t pcf85063a_tz_offset(int64_t utc_epoch);
+int64_t pcf85063a_tz_to_local(int64_t utc_epoch);
+rtc_error_t pcf85063a_local_now_ms(const struct device *dev, int64_t *local_ms);
+rtc_error_t pcf85063a_local_time_block(const struct device *dev, uint8_t *time_block);
+
+#endif
@@ -4,15 +4,28 @@
 
 LOG_MODULE_REGISTER(main, CONFIG_LOG_DEFAULT_LEVEL);
 
+#ifndef CONFIG_PCF85063A_BUILD_TIME
+// Seconds, minutes, hours, day, weekday, month, year of 2000-01-01, a Saturday
+static const uint8_t default_time[7] = {0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x00};
+#endif
+
 int main(void)
 {
-        uint8_t ret;
-        uint8_t * time_array = get_civic_time();
-        ret = initialize_RTC(time_array);
+        rtc_error_t ret;
+        bool warm_boot;
+#ifdef CONFIG_PCF85063A_BUILD_TIME
+        const uint8_t *time_array = get_civic_time();
+#else
+        const uint8_t *time_array = default_time;
+#endif
+        ret = initialize_RTC_warm(time_array, &warm_boot);
         if (ret != RTC_SUCCESS) {
                 LOG_INF("RTC initialzation failed");
                 return RTC_ERROR_DEVICE_SETUP;
         }
+        else if (warm_boot) {
+                LOG_INF("RTC time kept across reset");
+        }
         else {
                 LOG_INF("RTC initialized successfully");
         }
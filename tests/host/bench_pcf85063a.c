@@ -0,0 +1,217 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "PCF85063A_bus.h"
+#include "PCF85063A_core.h"
+#include "mock_bus.h"
+
+/*
+ * Host micro-benchmark of the Zephyr-free driver core. Every case is checked
+ * against known results first, so a wrong optimization fails instead of
+ * looking fast. Prints one "<case> <ns>/op" line per case.
+ *
+ * Usage: pcf85063a_bench [-n iterations]
+ */
+
+#define DEFAULT_ITERATIONS 2000000
+
+// Results are folded into this so the compiler cannot drop the measured calls
+static volatile uint32_t sink;
+
+static const uint8_t time_blocks[8][RTC_TIME_REGISTER_SIZE] = {
+    {0x00, 0x00, 0x12, 0x15, 0x06, 0x07, 0x23}, // 12:00:00 Sat Jul 15 2023
+    {0x59, 0x59, 0x23, 0x31, 0x00, 0x12, 0x99}, // 23:59:59 Thu Dec 31 2099
+    {0x30, 0x45, 0x08, 0x29, 0x04, 0x02, 0x24}, // Leap day 2024
+    {0x01, 0x02, 0x03, 0x01, 0x06, 0x01, 0x00}, // Jan 1 2000
+    {0x00, 0x00, 0x12, 0x15, 0x06, 0x07, 0x23},
+    {0x12, 0x34, 0x16, 0x28, 0x01, 0x02, 0x25},
+    {0x00, 0x00, 0x00, 0x30, 0x02, 0x02, 0x24}, // Feb 30, invalid
+    {0x5A, 0x00, 0x12, 0x15, 0x06, 0x07, 0x23}, // Bad BCD nibble, invalid
+};
+
+static const uint8_t alarm_blocks[8][RTC_ALARM_REGISTER_SIZE] = {
+    {0x30, 0x10, 0x12, 0x15, 0x00},
+    {0x59, 0x59, 0x23, 0x31, 0x00},
+    {0x05, 0x80, 0x80, 0x80, 0x80}, // Every minute at :05
+    {0x00, 0x30, 0x07, 0x80, 0x06}, // Saturdays at 07:30:00
+    {0x00, 0x60, 0x12, 0x15, 0x00}, // Minute 60, invalid
+    {0x00, 0x00, 0x12, 0x00, 0x00}, // Day 0, invalid
+    {0x00, 0x00, 0x12, 0x80, 0x07}, // Weekday 7, invalid
+    {0x80, 0x80, 0x80, 0x80, 0x80}, // Nothing to match, invalid
+};
+
+// Central European Time 2023: CET, CEST from Mar 26 01:00 UTC, CET from Oct 29 01:00 UTC
+static const uint32_t tz_starts[3] = {0, 1679792400, 1698541200};
+static const int16_t tz_offsets[3] = {60, 120, 60};
+static const struct rtc_tz_table tz_table = {tz_starts, tz_offsets, 3};
+
+static const char *const month_names[12] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                            "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+static int failures;
+
+static void check(int condition, const char *what)
+{
+    if (!condition) {
+        fprintf(stderr, "FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Times iterations runs of body, i is the iteration number inside body
+#define BENCH(name, iterations, body)                                                          \
+    do {                                                                                       \
+        const uint64_t start = now_ns();                                                       \
+        for (uint32_t i = 0; i < (iterations); i++) {                                          \
+            body;                                                                              \
+        }                                                                                      \
+        const double ns = (double)(now_ns() - start) / (iterations);                           \
+        printf("%-28s %8.2f ns/op\n", name, ns);                                               \
+    } while (0)
+
+/**
+ * @brief Checks every benchmarked function against known results
+ *
+ * @param mock Mock bus holding time_blocks[0]
+ */
+static void self_check(struct mock_bus *mock)
+{
+    uint8_t fields[RTC_TIME_REGISTER_SIZE];
+    uint8_t block[RTC_TIME_REGISTER_SIZE];
+    const uint8_t expected[RTC_TIME_REGISTER_SIZE] = {0, 0, 12, 15, 6, 7, 23};
+
+    check(convert_to_bcd(59) == 0x59 && convert_to_bcd(7) == 0x07, "convert_to_bcd");
+    check(bcd_to_decimal(0x59) == 59 && bcd_to_decimal(0x07) == 7, "bcd_to_decimal");
+    check(extract_time_component("12:34:56", 3) == 0x34, "extract_time_component");
+    check(find_month("Jan") == 1 && find_month("Dec") == 12 && find_month("Xyz") == 0, "find_month");
+
+    for (int i = 0; i < 8; i++) {
+        check(rtc_time_block_is_valid(time_blocks[i]) == (i < 6), "rtc_time_block_is_valid");
+    }
+    for (int i = 0; i < 8; i++) {
+        check(rtc_alarm_block_is_valid(alarm_blocks[i]) == (i < 4), "rtc_alarm_block_is_valid");
+    }
+
+    rtc_time_block_to_binary(time_blocks[0], fields);
+    check(memcmp(fields, expected, sizeof(fields)) == 0, "rtc_time_block_to_binary");
+    rtc_time_block_to_bcd(fields, block);
+    check(memcmp(block, time_blocks[0], sizeof(block)) == 0, "rtc_time_block_to_bcd");
+    check(rtc_time_block_to_epoch(time_blocks[0]) == 1689422400, "rtc_time_block_to_epoch");
+
+    size_t hint = 0;
+    check(rtc_tz_offset(&tz_table, 1679792399, &hint) == 3600 &&
+              rtc_tz_offset(&tz_table, 1679792400, &hint) == 7200 && hint == 1 &&
+              rtc_tz_offset(&tz_table, 1698541200, &hint) == 3600 &&
+              rtc_tz_offset(&tz_table, -1, &hint) == 3600,
+          "rtc_tz_offset");
+
+    check(rtc_drift_ppb(3600360000LL, 3600000000LL) == 100000 &&
+              rtc_drift_ppb(863999136000LL, 864000000000LL) == -1000,
+          "rtc_drift_ppb");
+    check(rtc_offset_from_ppb(-100000) == 0x17 && rtc_offset_from_ppb(12207) == 0xFD &&
+              rtc_offset_to_ppb(0x17) == -23 * RTC_OFFSET_NORMAL_STEP_PPB &&
+              rtc_offset_to_ppb(0xFD) == 3 * RTC_OFFSET_FAST_STEP_PPB,
+          "rtc_offset_from_ppb");
+    // A crystal 100 ppm fast needs a positive register value, which drops clock pulses
+    check(rtc_offset_from_ppb(-rtc_drift_ppb(3600360000LL, 3600000000LL)) == 0x17,
+          "rtc_offset_from_ppb known drift");
+
+    // Opens after 3 failures in a row, one failed probe reopens it, one good probe closes it
+    const struct rtc_bus_policy policy = {50, 2, 1, 3, 1000};
+    struct rtc_breaker breaker = {0};
+    check(!rtc_breaker_record(&breaker, &policy, false, 0) &&
+              !rtc_breaker_record(&breaker, &policy, true, 0) &&
+              !rtc_breaker_record(&breaker, &policy, false, 0) &&
+              !rtc_breaker_record(&breaker, &policy, false, 0) &&
+              rtc_breaker_record(&breaker, &policy, false, 10) && breaker.state == RTC_BREAKER_OPEN,
+          "rtc_breaker_record trip");
+    check(!rtc_breaker_allow(&breaker, 1009) && rtc_breaker_allow(&breaker, 1010) &&
+              !rtc_breaker_allow(&breaker, 1010) &&
+              rtc_breaker_record(&breaker, &policy, false, 1010) &&
+              !rtc_breaker_allow(&breaker, 2009) && rtc_breaker_allow(&breaker, 2010) &&
+              !rtc_breaker_record(&breaker, &policy, true, 2010) &&
+              breaker.state == RTC_BREAKER_CLOSED && breaker.trips == 2,
+          "rtc_breaker_allow probe");
+    check(rtc_retry_backoff_ms(&policy, 0) == 1 && rtc_retry_backoff_ms(&policy, 3) == 8 &&
+              rtc_retry_backoff_ms(&policy, 200) == 50,
+          "rtc_retry_backoff_ms");
+
+    // The full decode is one 7-byte burst read of the time block
+    const uint32_t logged = mock->logged;
+    memset(fields, 0xFF, sizeof(fields));
+    check(pcf85063a_bus_get_time(&mock->bus, fields) == RTC_SUCCESS, "pcf85063a_bus_get_time");
+    check(memcmp(fields, expected, sizeof(fields)) == 0, "pcf85063a_bus_get_time fields");
+    const struct mock_bus_transaction *read = mock_bus_last(mock, 0);
+    check(mock->logged == logged + 1 && read->read &&
+              read->start_address == RTC_TIME_REGISTER_ADDRESS &&
+              read->size == RTC_TIME_REGISTER_SIZE,
+          "pcf85063a_bus_get_time bus traffic");
+
+    mock->registers[RTC_TIME_REGISTER_ADDRESS + SECONDS_INDEX] |= RTC_OSCILLATOR_STOPPED;
+    check(pcf85063a_bus_get_time(&mock->bus, fields) == RTC_ERROR_INVALID_PARAMETER,
+          "pcf85063a_bus_get_time with OS set");
+    mock->registers[RTC_TIME_REGISTER_ADDRESS + SECONDS_INDEX] &= ~RTC_OSCILLATOR_STOPPED;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    struct mock_bus mock;
+    uint8_t fields[RTC_TIME_REGISTER_SIZE];
+    uint8_t block[RTC_TIME_REGISTER_SIZE];
+    size_t hint = 0;
+
+    if (argc == 3 && strcmp(argv[1], "-n") == 0) {
+        iterations = strtoul(argv[2], NULL, 0);
+    }
+    if (iterations == 0) {
+        fprintf(stderr, "Usage: %s [-n iterations]\n", argv[0]);
+        return 2;
+    }
+
+    mock_bus_init(&mock);
+    memcpy(&mock.registers[RTC_TIME_REGISTER_ADDRESS], time_blocks[0], RTC_TIME_REGISTER_SIZE);
+
+    self_check(&mock);
+    if (failures != 0) {
+        return 1;
+    }
+
+    BENCH("convert_to_bcd", iterations, sink += convert_to_bcd(i % 100));
+    BENCH("bcd_to_decimal", iterations, sink += bcd_to_decimal(time_blocks[i & 7][i % 7]));
+    BENCH("find_month", iterations, sink += find_month(month_names[i % 12]));
+    BENCH("rtc_time_block_to_binary", iterations,
+          (rtc_time_block_to_binary(time_blocks[i & 7], fields), sink += fields[i % 7]));
+    BENCH("rtc_time_block_to_bcd", iterations,
+          (rtc_time_block_to_bcd(time_blocks[i & 3], block), sink += block[i % 7]));
+    BENCH("rtc_time_block_is_valid", iterations,
+          sink += rtc_time_block_is_valid(time_blocks[i & 7]));
+    BENCH("rtc_alarm_block_is_valid", iterations,
+          sink += rtc_alarm_block_is_valid(alarm_blocks[i & 7]));
+    BENCH("rtc_time_block_to_epoch", iterations,
+          sink += (uint32_t)rtc_time_block_to_epoch(time_blocks[i & 3]));
+    // Consecutive seconds stay in the cached interval, seconds a day apart cross transitions
+    BENCH("rtc_tz_offset cached", iterations,
+          sink += rtc_tz_offset(&tz_table, 1689422400 + i % 86400, &hint));
+    BENCH("rtc_tz_offset search", iterations,
+          sink += rtc_tz_offset(&tz_table, 1672531200 + (i * 86400u) % 31536000, &hint));
+    BENCH("rtc_drift_ppb", iterations,
+          sink += rtc_drift_ppb(7200000000LL + (i & 0xFFFF), 7200000000LL));
+    BENCH("rtc_offset_from_ppb", iterations,
+          sink += rtc_offset_from_ppb((int32_t)(i % 600000) - 300000));
+    BENCH("pcf85063a_bus_get_time", iterations,
+          (sink += pcf85063a_bus_get_time(&mock.bus, fields), sink += fields[i % 7]));
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <errno.h>
+#include <string.h>
+#include "mock_bus.h"
+
+/**
+ * @brief Appends one burst to the transaction log
+ *
+ * @param mock Mock bus
+ * @param read True for a read burst
+ * @param start_address First register of the burst
+ * @param size Number of registers in the burst
+ */
+static void mock_bus_record(struct mock_bus *mock, bool read, uint8_t start_address, uint8_t size)
+{
+    struct mock_bus_transaction *entry = &mock->log[mock->logged % MOCK_BUS_LOG_SIZE];
+
+    entry->transfer = mock->transfers;
+    entry->read = read;
+    entry->start_address = start_address;
+    entry->size = size;
+    mock->logged++;
+}
+
+/**
+ * @brief Bus API: reads from the register array
+ */
+static int mock_bus_read(const struct pcf85063a_bus *bus, uint8_t start_address, uint8_t *buffer,
+                         uint8_t size)
+{
+    struct mock_bus *mock = (struct mock_bus *)bus->ctx;
+
+    mock->transfers++;
+    mock_bus_record(mock, true, start_address, size);
+    if (mock->fail_with != 0) {
+        return mock->fail_with;
+    }
+    if (size == 0 || start_address + size > RTC_REGISTER_SIZE) {
+        return -EINVAL;
+    }
+
+    memcpy(buffer, &mock->registers[start_address], size);
+    return 0;
+}
+
+/**
+ * @brief Bus API: writes to the register array with the chip's flag semantics
+ *
+ * AF and TF in Control_2 are only cleared by writing 0, writing 1 leaves them as they are.
+ */
+static int mock_bus_write(const struct pcf85063a_bus *bus, const struct pcf85063a_burst *bursts,
+                          size_t count)
+{
+    struct mock_bus *mock = (struct mock_bus *)bus->ctx;
+    const uint8_t flags = RTC_CTRL2_AF | RTC_CTRL2_TF;
+
+    mock->transfers++;
+    for (size_t i = 0; i < count; i++) {
+        mock_bus_record(mock, false, bursts[i].start_address, bursts[i].size);
+    }
+    if (mock->fail_with != 0) {
+        return mock->fail_with;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (bursts[i].size == 0 || bursts[i].start_address + bursts[i].size > RTC_REGISTER_SIZE) {
+            return -EINVAL;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        for (uint8_t j = 0; j < bursts[i].size; j++) {
+            const uint8_t reg = bursts[i].start_address + j;
+            const uint8_t value = bursts[i].data[j];
+
+            if (reg == RTC_CONTROL_2_ADDRESS) {
+                mock->registers[reg] = (value & ~flags) | (mock->registers[reg] & value & flags);
+            } else {
+                mock->registers[reg] = value;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Bus API: records the state of the INT line
+ */
+static int mock_bus_irq_enable(const struct pcf85063a_bus *bus, bool enable)
+{
+    struct mock_bus *mock = (struct mock_bus *)bus->ctx;
+
+    mock->irq_enabled = enable;
+    return 0;
+}
+
+static const struct pcf85063a_bus_api mock_bus_api = {
+    .read = mock_bus_read,
+    .write = mock_bus_write,
+    .irq_enable = mock_bus_irq_enable,
+};
+
+/**
+ * @brief Resets the mock to the chip's power-on state with an empty log
+ *
+ * @param mock Mock bus
+ * @note Seconds reads with OS set and Timer_mode with TCF at 1/60 Hz, as after power-on.
+ */
+void mock_bus_init(struct mock_bus *mock)
+{
+    memset(mock, 0, sizeof(*mock));
+    mock->bus.api = &mock_bus_api;
+    mock->bus.ctx = mock;
+    mock->registers[RTC_TIME_REGISTER_ADDRESS + SECONDS_INDEX] = RTC_OSCILLATOR_STOPPED;
+    mock->registers[RTC_TIME_REGISTER_ADDRESS + DATE_INDEX] = 0x01;
+    mock->registers[RTC_TIME_REGISTER_ADDRESS + WEEKDAY_INDEX] = 0x06;
+    mock->registers[RTC_TIME_REGISTER_ADDRESS + MONTH_INDEX] = 0x01;
+    mock->registers[RTC_TIMER_MODE_ADDRESS] = RTC_TIMER_MODE_TCF_MASK;
+}
+
+/**
+ * @brief Returns a logged burst
+ *
+ * @param mock Mock bus
+ * @param age 0 for the latest burst, 1 for the one before it, ...
+ * @return const struct mock_bus_transaction* The burst, or NULL if it is not in the log
+ */
+const struct mock_bus_transaction *mock_bus_last(const struct mock_bus *mock, uint32_t age)
+{
+    if (age >= mock->logged || age >= MOCK_BUS_LOG_SIZE) {
+        return NULL;
+    }
+
+    return &mock->log[(mock->logged - 1 - age) % MOCK_BUS_LOG_SIZE];
+}
@@ -0,0 +1,34 @@
+#ifndef PCF85063A_MOCK_BUS_H
+#define PCF85063A_MOCK_BUS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "PCF85063A_bus.h"
+
+// Number of most recent bursts kept in the transaction log
+#define MOCK_BUS_LOG_SIZE 64
+
+// One read or one write burst as seen on the bus
+struct mock_bus_transaction {
+    uint32_t transfer; // Bursts of one multi-burst write share the transfer number
+    bool read;
+    uint8_t start_address;
+    uint8_t size;
+};
+
+// Register-array model of the chip behind the bus API
+struct mock_bus {
+    struct pcf85063a_bus bus;
+    uint8_t registers[RTC_REGISTER_SIZE];
+    bool irq_enabled;
+    int fail_with;      // Negative errno returned by every transfer while set
+    uint32_t transfers; // Transfers attempted since mock_bus_init()
+    uint32_t logged;    // Bursts logged since mock_bus_init(), the log keeps the latest
+    struct mock_bus_transaction log[MOCK_BUS_LOG_SIZE];
+};
+
+void mock_bus_init(struct mock_bus *mock);
+const struct mock_bus_transaction *mock_bus_last(const struct mock_bus *mock, uint32_t age);
+
+#endif
@@ -1,9 +1,66 @@
 #include <zephyr/ztest.h>
+#include <zephyr/drivers/rtc.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/pm/device_runtime.h>
 #include "PCF85063A.h"
+#ifdef CONFIG_PCF85063A_TIMESTAMP
+#include "PCF85063A_timestamp.h"
+#endif
+#include "PCF85063A_alarm_mux.h"
+#include "PCF85063A_stats.h"
+#include "PCF85063A_journal.h"
+#include "PCF85063A_tz.h"
+#include "PCF85063A_calib.h"
+
+static const struct device *const rtc_dev = DEVICE_DT_GET_ONE(nxp_pcf85063a);
+
+#ifdef CONFIG_EMUL
+#include "PCF85063A_emul.h"
+static const struct emul *const rtc_emul = EMUL_DT_GET(DT_NODELABEL(pcf85063a));
+#endif
+
+/**
+ * @brief Lets the RTC run for the given number of seconds
+ *
+ * On the emulator this advances virtual time instantly, on hardware it sleeps.
+ */
+static void rtc_run_seconds(uint32_t seconds)
+{
+#ifdef CONFIG_EMUL
+    pcf85063a_emul_advance(rtc_emul, seconds * MSEC_PER_SEC);
+#else
+    k_msleep(seconds * MSEC_PER_SEC);
+#endif
+}
+
+/**
+ * @brief Returns the time the tests seed the RTC with
+ *
+ * The build time with CONFIG_PCF85063A_BUILD_TIME, the start of the chip's range otherwise.
+ */
+static const uint8_t *seed_time(void)
+{
+#ifdef CONFIG_PCF85063A_BUILD_TIME
+    return get_civic_time();
+#else
+    // 00:00:00 Saturday Jan 1 2000
+    static const uint8_t range_start[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x00};
+    return range_start;
+#endif
+}
 
 
 ZTEST_SUITE(pcf85063a_tests, NULL, NULL, NULL, NULL, NULL);
 
+static K_SEM_DEFINE(async_done, 0, 2);
+static rtc_error_t async_results[2];
+
+static void async_test_callback(rtc_error_t result, void *user_data)
+{
+    async_results[(uintptr_t)user_data] = result;
+    k_sem_give(&async_done);
+}
+
 /**
  * @brief Test the convert_to_bcd function
  *
@@ -45,6 +102,53 @@ ZTEST(pcf85063a_tests, test_extract_time_component)
     zassert_equal(extract_time_component(time_str, 6), 0x56, "extract_time_component failed for seconds");
 }
 
+/**
+ * @brief Test the packed time block codec and validator
+ *
+ * This test checks the conversion of whole time blocks in both directions,
+ * the batch converter, and that bad nibbles and impossible dates are rejected.
+ */
+ZTEST(pcf85063a_tests, test_time_block_codec)
+{
+    const uint8_t bcd[RTC_TIME_REGISTER_SIZE] = {0x59, 0x07, 0x23, 0x29, 0x04, 0x02, 0x24};
+    const uint8_t binary[RTC_TIME_REGISTER_SIZE] = {59, 7, 23, 29, 4, 2, 24};
+    uint8_t converted[RTC_TIME_REGISTER_SIZE];
+
+    rtc_time_block_to_binary(bcd, converted);
+    zassert_mem_equal(converted, binary, sizeof(binary), "BCD to binary failed");
+    rtc_time_block_to_bcd(binary, converted);
+    zassert_mem_equal(converted, bcd, sizeof(bcd), "Binary to BCD failed");
+    zassert_true(rtc_time_block_is_valid(bcd), "Feb 29 2024 should be valid");
+
+    // OS flag is ignored by the codec
+    const uint8_t stopped[RTC_TIME_REGISTER_SIZE] = {0xD9, 0x07, 0x23, 0x29, 0x04, 0x02, 0x24};
+    rtc_time_block_to_binary(stopped, converted);
+    zassert_equal(converted[SECONDS_INDEX], 59, "OS flag not masked");
+
+    const uint8_t bad_nibble[RTC_TIME_REGISTER_SIZE] = {0x1A, 0x00, 0x00, 0x01, 0x00, 0x01, 0x24};
+    const uint8_t not_leap[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x00, 0x29, 0x00, 0x02, 0x23};
+    const uint8_t feb_31[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x00, 0x31, 0x00, 0x02, 0x24};
+    const uint8_t day_zero[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x24};
+    zassert_false(rtc_time_block_is_valid(bad_nibble), "0x1A seconds should be rejected");
+    zassert_false(rtc_time_block_is_valid(not_leap), "Feb 29 2023 should be rejected");
+    zassert_false(rtc_time_block_is_valid(feb_31), "Feb 31 should be rejected");
+    zassert_false(rtc_time_block_is_valid(day_zero), "Day 0 should be rejected");
+#ifdef CONFIG_PCF85063A_VALIDATION
+    zassert_equal(initialize_RTC(feb_31), RTC_ERROR_INVALID_PARAMETER, "initialize_RTC should reject Feb 31");
+#endif
+
+    const uint8_t batch[3][RTC_TIME_REGISTER_SIZE] = {
+        {0x59, 0x07, 0x23, 0x29, 0x04, 0x02, 0x24},
+        {0x00, 0x00, 0x00, 0x29, 0x00, 0x02, 0x23},
+        {0x30, 0x45, 0x12, 0x15, 0x06, 0x07, 0x23},
+    };
+    uint8_t batch_binary[3][RTC_TIME_REGISTER_SIZE];
+    zassert_equal(rtc_time_blocks_to_binary(batch, batch_binary, 3), 1, "Batch should flag one invalid block");
+    zassert_mem_equal(batch_binary[0], binary, sizeof(binary), "Batch conversion failed");
+    zassert_equal(batch_binary[2][MINUTES_INDEX], 45, "Batch conversion failed");
+}
+
+#ifdef CONFIG_PCF85063A_BUILD_TIME
 /**
  * @brief Test the get_civic_time function
  *
@@ -54,7 +158,7 @@ ZTEST(pcf85063a_tests, test_extract_time_component)
  */
 ZTEST(pcf85063a_tests, test_get_civic_time)
 {
-    uint8_t *time_array = get_civic_time();
+    const uint8_t *time_array = get_civic_time();
     zassert_not_null(time_array, "get_civic_time returned NULL");
     
     // Verify the time format (e.g., hours, minutes, seconds)
@@ -63,12 +167,12 @@ ZTEST(pcf85063a_tests, test_get_civic_time)
     zassert_true(time_array[MINUTES_INDEX] <= 0x60, "Invalid minutes value");
     zassert_true(time_array[HOURS_INDEX] < 0x24, "Invalid hours value");
     zassert_true(time_array[DATE_INDEX] > 0x00 && time_array[3] <= 0x31, "Invalid day value, %d", time_array[3]);
-    zassert_true(time_array[WEEKDAY_INDEX] == 0, "Invalid date value"); // This is not set as it is unncessary in clock and difficult to obtain
+    zassert_true(time_array[WEEKDAY_INDEX] <= 0x06, "Invalid weekday value");
     zassert_true(time_array[MONTH_INDEX] >= 0x01 && time_array[5] <= 0x012, "Invalid month value");
     zassert_true(time_array[YEAR_INDEX] <= 0x99, "Invalid year value");
 
     // Verify consistency
-    uint8_t *time_array2 = get_civic_time();
+    const uint8_t *time_array2 = get_civic_time();
     zassert_not_null(time_array2, "get_civic_time returned NULL on second call");
     zassert_mem_equal(time_array, time_array2, RTC_TIME_REGISTER_SIZE, "Inconsistent time returned by get_civic_time");
     
@@ -79,6 +183,7 @@ ZTEST(pcf85063a_tests, test_get_civic_time)
         zassert_true((time_array[i] & 0x0F) <= 0x09, "Invalid BCD format (low nibble) at index %d", i);
     }
 }
+#endif
 
 
 /**
@@ -90,7 +195,7 @@ ZTEST(pcf85063a_tests, test_get_civic_time)
  */
 ZTEST(pcf85063a_tests, test_initialize_rtc)
 {
-    uint8_t * time_array = get_civic_time();
+    const uint8_t *time_array = seed_time();
     rtc_error_t ret = initialize_RTC(time_array);
     zassert_equal(ret, RTC_SUCCESS, "initialize_RTC failed");
     
@@ -106,7 +211,7 @@ ZTEST(pcf85063a_tests, test_initialize_rtc)
     ret = write_register(current_time, sizeof(current_time), RTC_TIME_REGISTER_ADDRESS);
     zassert_equal(ret, RTC_SUCCESS, "Failed to set current time");
 
-    k_msleep(3000); 
+    rtc_run_seconds(3);
     // Test all registers progressing from max to min val. Time should be 0x02, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00
     ret = read_register(read_buffer, RTC_TIME_REGISTER_SIZE, RTC_TIME_REGISTER_ADDRESS);
     zassert_equal(ret, RTC_SUCCESS, "Failed to read back time");
@@ -114,7 +219,7 @@ ZTEST(pcf85063a_tests, test_initialize_rtc)
     zassert_true(read_buffer[MINUTES_INDEX] == 0x00, "Clock minutes not progressing correctly");
     zassert_true(read_buffer[HOURS_INDEX] == 0x00, "Clock hours not progressing correctly");
     zassert_true(read_buffer[DATE_INDEX] == 0x01, "Clock date not progressing correctly");
-    zassert_true(time_array[WEEKDAY_INDEX] == 0x00, "Invalid weekday index value");
+    zassert_true(read_buffer[WEEKDAY_INDEX] == 0x01, "Clock weekday not progressing correctly");
     zassert_true(read_buffer[MONTH_INDEX] == 0x01, "Clock month not progressing correctly");
     zassert_true(read_buffer[YEAR_INDEX] == 0x00, "Clock year not progressing correctly");
 }
@@ -137,6 +242,421 @@ ZTEST(pcf85063a_tests, test_read_write_register)
     zassert_mem_equal(write_buffer, read_buffer, sizeof(read_buffer), "Read data doesn't match written data");
 }
 
+/**
+ * @brief Test the register shadow cache
+ *
+ * This test checks that a non-volatile register reads back the written
+ * value both when served from the shadow and after the shadow is dropped.
+ */
+ZTEST(pcf85063a_tests, test_register_cache)
+{
+    uint8_t ram_byte = 0xA5;
+    rtc_error_t ret = write_register(&ram_byte, sizeof(ram_byte), RTC_RAM_BYTE_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "write_register failed");
+
+    uint8_t read_back = 0;
+    ret = read_register(&read_back, sizeof(read_back), RTC_RAM_BYTE_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "Cached read_register failed");
+    zassert_equal(read_back, ram_byte, "Cached RAM byte doesn't match written data");
+
+    rtc_cache_invalidate();
+    read_back = 0;
+    ret = read_register(&read_back, sizeof(read_back), RTC_RAM_BYTE_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "Uncached read_register failed");
+    zassert_equal(read_back, ram_byte, "RAM byte on the chip doesn't match written data");
+}
+
+/**
+ * @brief Test the register transaction builder
+ *
+ * This test stages writes to two adjacent registers and a bit update of a
+ * third one, commits them together and checks that the untouched bits of
+ * the updated register survive.
+ */
+ZTEST(pcf85063a_tests, test_transaction)
+{
+    struct pcf85063a_txn txn;
+    uint8_t offset_and_ram[2] = {0x11, 0x22};
+    uint8_t timer_mode = RTC_TIMER_MODE_TCF_MASK;
+
+    zassert_equal(write_register(&timer_mode, sizeof(timer_mode), RTC_TIMER_MODE_ADDRESS), RTC_SUCCESS,
+                  "Failed to reset Timer_mode");
+
+    pcf85063a_txn_init(&txn, rtc_dev);
+    zassert_equal(pcf85063a_txn_write(&txn, offset_and_ram, sizeof(offset_and_ram), RTC_OFFSET_ADDRESS),
+                  RTC_SUCCESS, "pcf85063a_txn_write failed");
+    zassert_equal(pcf85063a_txn_update(&txn, RTC_TIMER_MODE_ADDRESS, RTC_TIMER_MODE_TIE, RTC_TIMER_MODE_TIE),
+                  RTC_SUCCESS, "pcf85063a_txn_update failed");
+    zassert_equal(pcf85063a_txn_write(&txn, offset_and_ram, 1, RTC_REGISTER_SIZE), RTC_ERROR_INVALID_PARAMETER,
+                  "pcf85063a_txn_write should reject addresses past the register file");
+
+#ifdef CONFIG_PCF85063A_STATS
+    struct pcf85063a_op_stats stats;
+    pcf85063a_stats_reset();
+#endif
+    zassert_equal(pcf85063a_txn_commit(&txn), RTC_SUCCESS, "pcf85063a_txn_commit failed");
+#ifdef CONFIG_PCF85063A_STATS
+    pcf85063a_stats_get(PCF85063A_STATS_WRITE, &stats);
+    zassert_equal(stats.calls, 1, "Expected one bus transfer per commit, got %u", stats.calls);
+#endif
+
+    rtc_cache_invalidate();
+    uint8_t read_buffer[2];
+    zassert_equal(read_register(read_buffer, sizeof(read_buffer), RTC_OFFSET_ADDRESS), RTC_SUCCESS,
+                  "Failed to read back Offset and RAM_byte");
+    zassert_mem_equal(read_buffer, offset_and_ram, sizeof(offset_and_ram), "Staged writes not committed");
+    zassert_equal(read_register(&timer_mode, sizeof(timer_mode), RTC_TIMER_MODE_ADDRESS), RTC_SUCCESS,
+                  "Failed to read back Timer_mode");
+    zassert_equal(timer_mode, RTC_TIMER_MODE_TCF_MASK | RTC_TIMER_MODE_TIE, "Timer_mode update lost bits");
+
+    timer_mode = RTC_TIMER_MODE_TCF_MASK;
+    zassert_equal(write_register(&timer_mode, sizeof(timer_mode), RTC_TIMER_MODE_ADDRESS), RTC_SUCCESS,
+                  "Failed to reset Timer_mode");
+}
+
+#define CONCURRENT_READERS 4
+
+K_THREAD_STACK_ARRAY_DEFINE(reader_stacks, CONCURRENT_READERS, 1024);
+static struct k_thread reader_threads[CONCURRENT_READERS];
+static int64_t reader_epochs[CONCURRENT_READERS];
+static rtc_error_t reader_results[CONCURRENT_READERS];
+
+static void time_reader(void *index, void *unused1, void *unused2)
+{
+    const int i = POINTER_TO_INT(index);
+    reader_results[i] = rtc_get_epoch(&reader_epochs[i]);
+}
+
+/**
+ * @brief Test concurrent time reads
+ *
+ * This test starts several threads that read the time at once, while the
+ * test thread writes the RAM byte, and checks that every reader gets the
+ * time and no reader needed more than one bus read.
+ */
+ZTEST(pcf85063a_tests, test_concurrent_time_reads)
+{
+    uint8_t current_time[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x12, 0x15, 0x00, 0x07, 0x23};
+    zassert_equal(write_register(current_time, sizeof(current_time), RTC_TIME_REGISTER_ADDRESS), RTC_SUCCESS,
+                  "Failed to set time");
+
+#ifdef CONFIG_PCF85063A_STATS
+    struct pcf85063a_op_stats stats;
+    pcf85063a_stats_reset();
+#endif
+    for (int i = 0; i < CONCURRENT_READERS; i++) {
+        k_thread_create(&reader_threads[i], reader_stacks[i], K_THREAD_STACK_SIZEOF(reader_stacks[i]),
+                        time_reader, INT_TO_POINTER(i), NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+    }
+
+    uint8_t ram_byte = 0x5A;
+    zassert_equal(write_register(&ram_byte, sizeof(ram_byte), RTC_RAM_BYTE_ADDRESS), RTC_SUCCESS,
+                  "Write alongside the readers failed");
+
+    for (int i = 0; i < CONCURRENT_READERS; i++) {
+        zassert_equal(k_thread_join(&reader_threads[i], K_SECONDS(1)), 0, "Reader %d did not finish", i);
+        zassert_equal(reader_results[i], RTC_SUCCESS, "Reader %d failed", i);
+        zassert_within(reader_epochs[i], 1689422400LL, 1, "Reader %d got the wrong time", i);
+    }
+
+#ifdef CONFIG_PCF85063A_STATS
+    pcf85063a_stats_get(PCF85063A_STATS_READ, &stats);
+    zassert_true(stats.calls <= CONCURRENT_READERS, "Readers issued %u bus reads", stats.calls);
+#endif
+}
+
+/**
+ * @brief Test the rtc_fast_now function
+ *
+ * This test sets a known time and checks that the interpolated wall clock
+ * starts from it and keeps moving forward between resyncs.
+ */
+ZTEST(pcf85063a_tests, test_fast_now)
+{
+    // 12:00:00 Jul 15 2023 is 1689422400 seconds after the Unix epoch
+    uint8_t current_time[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x12, 0x15, 0x00, 0x07, 0x23};
+    rtc_error_t ret = write_register(current_time, sizeof(current_time), RTC_TIME_REGISTER_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "Failed to set current time");
+
+    int64_t first_ms = 0;
+    ret = rtc_fast_now(&first_ms);
+    zassert_equal(ret, RTC_SUCCESS, "rtc_fast_now failed");
+    zassert_true(first_ms >= 1689422400000LL && first_ms < 1689422402000LL,
+                 "Fast now %lld is not anchored to the RTC", first_ms);
+
+    k_msleep(50);
+    int64_t second_ms = 0;
+    ret = rtc_fast_now(&second_ms);
+    zassert_equal(ret, RTC_SUCCESS, "rtc_fast_now failed");
+    zassert_true(second_ms >= first_ms + 50, "Fast now did not advance with the CPU clock");
+
+    // Feb 30 is no time to anchor to
+    const uint8_t invalid_time[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x00, 0x30, 0x02, 0x02, 0x24};
+    ret = write_register(invalid_time, sizeof(invalid_time), RTC_TIME_REGISTER_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "Failed to write the invalid time");
+    zassert_equal(rtc_fast_now(&second_ms), RTC_ERROR_INVALID_PARAMETER, "Invalid time anchored");
+    ret = write_register(current_time, sizeof(current_time), RTC_TIME_REGISTER_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "Failed to restore the time");
+
+    zassert_equal(rtc_fast_now(NULL), RTC_ERROR_INVALID_PARAMETER, "rtc_fast_now should fail with NULL input");
+}
+
+/**
+ * @brief Test the Unix epoch conversion and the epoch get/set functions
+ */
+ZTEST(pcf85063a_tests, test_epoch)
+{
+    // 12:34:56 Feb 29 2024, a Thursday
+    const uint8_t leap_day[RTC_TIME_REGISTER_SIZE] = {0x56, 0x34, 0x12, 0x29, 0x04, 0x02, 0x24};
+    uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+
+    zassert_equal(rtc_time_block_to_epoch(leap_day), 1709210096LL, "Leap day converted incorrectly");
+    zassert_equal(rtc_epoch_to_time_block(1709210096LL, time_block), RTC_SUCCESS, "Epoch conversion failed");
+    zassert_mem_equal(time_block, leap_day, sizeof(leap_day), "Epoch did not convert back to the leap day");
+
+    zassert_equal(rtc_epoch_to_time_block(RTC_EPOCH_2000, time_block), RTC_SUCCESS, "2000-01-01 rejected");
+    zassert_equal(rtc_time_block_to_epoch(time_block), 946684800LL, "2000-01-01 converted incorrectly");
+    zassert_equal(time_block[WEEKDAY_INDEX], 6, "2000-01-01 was a Saturday");
+    zassert_equal(rtc_epoch_to_time_block(RTC_EPOCH_MAX, time_block), RTC_SUCCESS, "2099-12-31 rejected");
+    zassert_equal(rtc_time_block_to_epoch(time_block), 4102444799LL, "2099-12-31 converted incorrectly");
+    zassert_equal(rtc_epoch_to_time_block(RTC_EPOCH_2000 - 1, time_block), RTC_ERROR_INVALID_PARAMETER,
+                  "Epoch before 2000 should be rejected");
+    zassert_equal(rtc_epoch_to_time_block(RTC_EPOCH_MAX + 1, time_block), RTC_ERROR_INVALID_PARAMETER,
+                  "Epoch after 2099 should be rejected");
+
+    rtc_error_t ret = rtc_set_epoch(1709210096LL);
+    zassert_equal(ret, RTC_SUCCESS, "rtc_set_epoch failed");
+
+    int64_t epoch = 0;
+    ret = rtc_get_epoch(&epoch);
+    zassert_equal(ret, RTC_SUCCESS, "rtc_get_epoch failed");
+    zassert_true(epoch >= 1709210096LL && epoch < 1709210098LL, "Epoch %lld does not match the set time", epoch);
+
+    int64_t epoch_ms = 0;
+    ret = rtc_get_epoch_ms(&epoch_ms);
+    zassert_equal(ret, RTC_SUCCESS, "rtc_get_epoch_ms failed");
+    zassert_true(epoch_ms >= epoch * 1000 && epoch_ms < 1709210098000LL, "Epoch ms %lld is out of range", epoch_ms);
+
+    zassert_equal(rtc_set_epoch(0), RTC_ERROR_INVALID_PARAMETER, "rtc_set_epoch should reject 1970");
+    zassert_equal(rtc_get_epoch(NULL), RTC_ERROR_INVALID_PARAMETER, "rtc_get_epoch should fail with NULL input");
+}
+
+/**
+ * @brief Test the UTC offset lookup and the local time view
+ *
+ * This test looks up offsets in a table with the 2023 Central European DST
+ * transitions, then checks the compiled-in zone for consistency.
+ */
+ZTEST(pcf85063a_tests, test_time_zone)
+{
+    // CET, CEST from 2023-03-26 01:00 UTC, CET from 2023-10-29 01:00 UTC
+    static const uint32_t starts[] = {0, 1679792400, 1698541200};
+    static const int16_t offsets[] = {60, 120, 60};
+    const struct rtc_tz_table table = {starts, offsets, ARRAY_SIZE(starts)};
+    size_t hint = 0;
+
+    zassert_equal(rtc_tz_offset(&table, 1679792399, &hint), 3600, "Winter time before the switch");
+    zassert_equal(rtc_tz_offset(&table, 1679792400, &hint), 7200, "Summer time at the switch");
+    zassert_equal(hint, 1, "Hint not moved to the summer interval");
+    zassert_equal(rtc_tz_offset(&table, 1689422400, &hint), 7200, "Summer time in July");
+    zassert_equal(rtc_tz_offset(&table, 1698541200, &hint), 3600, "Winter time after the switch back");
+    zassert_equal(rtc_tz_offset(&table, -1, &hint), 3600, "Times before the table use its first offset");
+    zassert_equal(rtc_tz_offset(&table, 5000000000LL, &hint), 3600, "Times after 2106 use the last offset");
+
+#ifdef CONFIG_PCF85063A_TZ
+    // 12:00:00 Jul 15 2023 UTC
+    uint8_t current_time[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x12, 0x15, 0x06, 0x07, 0x23};
+    zassert_equal(write_register(current_time, sizeof(current_time), RTC_TIME_REGISTER_ADDRESS), RTC_SUCCESS,
+                  "Failed to set current time");
+
+    const int32_t offset = pcf85063a_tz_offset(1689422400LL);
+    zassert_true(offset % 60 == 0 && offset >= -12 * 3600 && offset <= 14 * 3600,
+                 "Offset %d of %s is not a valid UTC offset", offset, pcf85063a_tz_name());
+    zassert_equal(pcf85063a_tz_to_local(1689422400LL), 1689422400LL + offset, "Local time is not UTC plus offset");
+
+    int64_t local_ms = 0;
+    zassert_equal(pcf85063a_local_now_ms(rtc_dev, &local_ms), RTC_SUCCESS, "pcf85063a_local_now_ms failed");
+    zassert_within(local_ms, (1689422400LL + offset) * 1000, 2000, "Local time %lld is off", local_ms);
+
+    uint8_t local_block[RTC_TIME_REGISTER_SIZE];
+    zassert_equal(pcf85063a_local_time_block(rtc_dev, local_block), RTC_SUCCESS, "pcf85063a_local_time_block failed");
+    zassert_within(rtc_time_block_to_epoch(local_block), 1689422400LL + offset, 1, "Local time block is off");
+#endif
+}
+
+/**
+ * @brief Test the Offset register codec and the offset get/set functions
+ *
+ * This test checks the drift computation, the mode choice and the rounding of
+ * corrections, then programs a correction and reads it back.
+ */
+ZTEST(pcf85063a_tests, test_offset)
+{
+    zassert_equal(rtc_drift_ppb(3600360000LL, 3600000000LL), 100000, "100 ppm fast not measured");
+    zassert_equal(rtc_drift_ppb(863999136000LL, 864000000000LL), -1000, "1 ppm slow over 10 days not measured");
+    zassert_equal(rtc_drift_ppb(1000000, 0), 0, "An empty interval should not measure drift");
+
+    zassert_equal(rtc_offset_from_ppb(0), 0x00, "No correction should be normal mode 0");
+    zassert_equal(rtc_offset_from_ppb(-100000), 0x17, "-100 ppm should be normal mode +23");
+    zassert_equal(rtc_offset_from_ppb(12207), 0xFD, "12.2 ppm should be fast mode -3");
+    zassert_equal(rtc_offset_from_ppb(1000000), 0x40, "Large corrections should clamp to -64");
+    zassert_equal(rtc_offset_from_ppb(-1000000), 0x3F, "Large corrections should clamp to +63");
+    zassert_equal(rtc_offset_to_ppb(0x17), -23 * 4340, "Normal mode +23 decoded incorrectly");
+    zassert_equal(rtc_offset_to_ppb(0xFD), 3 * 4069, "Fast mode -3 decoded incorrectly");
+
+    // A crystal running 100 ppm fast is slowed down by a positive register value
+    const int32_t drift = rtc_drift_ppb(3600360000LL, 3600000000LL);
+    zassert_equal(rtc_offset_from_ppb(-drift), 0x17, "100 ppm fast should be cancelled by +23");
+
+    int32_t correction = 0;
+    zassert_equal(rtc_set_offset(-100000), RTC_SUCCESS, "rtc_set_offset failed");
+    zassert_equal(rtc_get_offset(&correction), RTC_SUCCESS, "rtc_get_offset failed");
+    zassert_equal(correction, -23 * 4340, "Offset %d read back incorrectly", correction);
+    zassert_equal(rtc_set_offset(0), RTC_SUCCESS, "rtc_set_offset failed to clear the offset");
+    zassert_equal(rtc_get_offset(NULL), RTC_ERROR_INVALID_PARAMETER, "rtc_get_offset should fail with NULL input");
+}
+
+#ifdef CONFIG_RTC_CALIBRATION
+/**
+ * @brief Test the calibration range of the Zephyr RTC API
+ *
+ * This test checks that every correction the Offset register can apply is
+ * accepted, including fast mode ones, and that larger ones are refused.
+ */
+ZTEST(pcf85063a_tests, test_rtc_api_calibration)
+{
+    int32_t calibration = 0;
+
+    zassert_equal(rtc_set_calibration(rtc_dev, RTC_OFFSET_MAX_PPB), 0, "Largest speed-up refused");
+    zassert_equal(rtc_get_calibration(rtc_dev, &calibration), 0, "rtc_get_calibration failed");
+    zassert_equal(calibration, RTC_OFFSET_MAX_PPB, "Calibration %d read back incorrectly", calibration);
+    zassert_equal(rtc_set_calibration(rtc_dev, RTC_OFFSET_MIN_PPB), 0, "Largest slow-down refused");
+    zassert_equal(rtc_set_calibration(rtc_dev, 12207), 0, "Fast mode correction refused");
+    zassert_equal(rtc_get_calibration(rtc_dev, &calibration), 0, "rtc_get_calibration failed");
+    zassert_equal(calibration, 3 * 4069, "Fast mode calibration %d read back incorrectly", calibration);
+    zassert_equal(rtc_set_calibration(rtc_dev, RTC_OFFSET_MAX_PPB + 1), -EINVAL, "Too large a correction accepted");
+    zassert_equal(rtc_set_calibration(rtc_dev, RTC_OFFSET_MIN_PPB - 1), -EINVAL, "Too large a correction accepted");
+    zassert_equal(rtc_set_calibration(rtc_dev, 0), 0, "rtc_set_calibration failed to clear the offset");
+}
+#endif
+
+#ifdef CONFIG_PCF85063A_TIMESTAMP
+/**
+ * @brief Test the microsecond timestamp service
+ *
+ * This test waits for the first second edge, then checks the timestamps
+ * against the set time and that they never go backwards. Setting the chip
+ * back by a minute must take the timestamps back instead of freezing them.
+ */
+ZTEST(pcf85063a_tests, test_timestamp)
+{
+    int64_t timestamp = 0;
+    zassert_equal(pcf85063a_timestamp_us(&timestamp), RTC_ERROR_DEVICE_SETUP,
+                  "Timestamps should be unavailable before the service starts");
+
+    zassert_equal(rtc_set_epoch(1709210096LL), RTC_SUCCESS, "rtc_set_epoch failed");
+    zassert_equal(pcf85063a_timestamp_start(rtc_dev), RTC_SUCCESS, "pcf85063a_timestamp_start failed");
+
+    rtc_error_t ret = RTC_ERROR_DEVICE_SETUP;
+    for (int i = 0; i < 3 && ret != RTC_SUCCESS; i++) {
+        k_msleep(20);
+        rtc_run_seconds(1);
+        k_msleep(1100);
+        ret = pcf85063a_timestamp_us(&timestamp);
+    }
+    zassert_equal(ret, RTC_SUCCESS, "Timestamp service did not sync to a second edge");
+    zassert_true(timestamp >= 1709210097000000LL && timestamp < 1709210100000000LL,
+                 "Timestamp %lld does not match the RTC time", timestamp);
+
+    int64_t previous = timestamp;
+    for (int i = 0; i < 10000; i++) {
+        zassert_equal(pcf85063a_timestamp_us(&timestamp), RTC_SUCCESS, "pcf85063a_timestamp_us failed");
+        zassert_true(timestamp >= previous, "Timestamp went backwards");
+        previous = timestamp;
+    }
+
+    zassert_equal(pcf85063a_timestamp_us(NULL), RTC_ERROR_INVALID_PARAMETER,
+                  "pcf85063a_timestamp_us should fail with NULL input");
+
+    zassert_equal(rtc_set_epoch(1709210036LL), RTC_SUCCESS, "rtc_set_epoch failed");
+    pcf85063a_timestamp_resync();
+    for (int i = 0; i < 3 && timestamp >= 1709210040000000LL; i++) {
+        k_msleep(20);
+        rtc_run_seconds(1);
+        k_msleep(1100);
+        zassert_equal(pcf85063a_timestamp_us(&timestamp), RTC_SUCCESS, "pcf85063a_timestamp_us failed");
+    }
+    zassert_true(timestamp >= 1709210037000000LL && timestamp < 1709210040000000LL,
+                 "Timestamp %lld did not follow the time set back", timestamp);
+    pcf85063a_timestamp_stop();
+}
+#endif
+
+/**
+ * @brief Test the async read and write register functions
+ *
+ * This test queues a write and a read back-to-back without waiting in
+ * between, then checks both callbacks and the data read back.
+ */
+ZTEST(pcf85063a_tests, test_async_read_write_register)
+{
+    uint8_t write_buffer[2] = {0x21, 0x43};
+    uint8_t read_buffer[2] = {0};
+
+    rtc_error_t ret = write_register_async(write_buffer, sizeof(write_buffer), RTC_OFFSET_ADDRESS,
+                                           async_test_callback, (void *)0);
+    zassert_equal(ret, RTC_SUCCESS, "write_register_async failed to queue");
+    ret = read_register_async(read_buffer, sizeof(read_buffer), RTC_OFFSET_ADDRESS,
+                              async_test_callback, (void *)1);
+    zassert_equal(ret, RTC_SUCCESS, "read_register_async failed to queue");
+
+    zassert_equal(k_sem_take(&async_done, K_MSEC(100)), 0, "Async write did not complete");
+    zassert_equal(k_sem_take(&async_done, K_MSEC(100)), 0, "Async read did not complete");
+    zassert_equal(async_results[0], RTC_SUCCESS, "Async write failed");
+    zassert_equal(async_results[1], RTC_SUCCESS, "Async read failed");
+    zassert_mem_equal(write_buffer, read_buffer, sizeof(read_buffer), "Read data doesn't match written data");
+
+    zassert_equal(read_register_async(NULL, 1, 0, NULL, NULL), RTC_ERROR_INVALID_PARAMETER,
+                  "read_register_async should fail with NULL buffer");
+}
+
+/**
+ * @brief Test the Zephyr RTC API implementation
+ *
+ * This test sets a broken-down time through rtc_set_time() and checks that
+ * rtc_get_time() and the raw time block both agree with it.
+ */
+ZTEST(pcf85063a_tests, test_rtc_api_time)
+{
+    zassert_true(device_is_ready(rtc_dev), "RTC device is not ready");
+
+    // 08:30:15 Saturday Jul 15 2023
+    struct rtc_time set = {
+        .tm_sec = 15, .tm_min = 30, .tm_hour = 8, .tm_mday = 15,
+        .tm_wday = 6, .tm_mon = 6, .tm_year = 123,
+    };
+    zassert_equal(rtc_set_time(rtc_dev, &set), 0, "rtc_set_time failed");
+
+    struct rtc_time get;
+    zassert_equal(rtc_get_time(rtc_dev, &get), 0, "rtc_get_time failed");
+    zassert_true(get.tm_sec >= 15 && get.tm_sec <= 17, "Seconds not kept");
+    zassert_equal(get.tm_min, 30, "Minutes not kept");
+    zassert_equal(get.tm_hour, 8, "Hours not kept");
+    zassert_equal(get.tm_mday, 15, "Day not kept");
+    zassert_equal(get.tm_wday, 6, "Weekday not kept");
+    zassert_equal(get.tm_mon, 6, "Month not kept");
+    zassert_equal(get.tm_year, 123, "Year not kept");
+
+    uint8_t read_buffer[RTC_TIME_REGISTER_SIZE];
+    rtc_error_t ret = pcf85063a_read_register(rtc_dev, read_buffer, sizeof(read_buffer), RTC_TIME_REGISTER_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "Failed to read back time");
+    zassert_equal(read_buffer[YEAR_INDEX], 0x23, "Year register not BCD encoded");
+
+    set.tm_year = 200;
+    zassert_equal(rtc_set_time(rtc_dev, &set), -EINVAL, "rtc_set_time should reject years past 2099");
+}
+
+#ifdef CONFIG_PCF85063A_ALARM
 /**
  * @brief Test the set_alarm function
  *
@@ -156,6 +676,70 @@ ZTEST(pcf85063a_tests, test_set_alarm)
     zassert_mem_equal(alarm_buffer, read_buffer, RTC_ALARM_REGISTER_SIZE, "Alarm not set correctly");
 }
 
+/**
+ * @brief Test that the async alarm keeps the other Control_2 settings
+ *
+ * This test turns CLKOUT off and enables the minute interrupt with the shadow
+ * dropped, queues the alarm asynchronously and checks that only AIE changed.
+ */
+ZTEST(pcf85063a_tests, test_set_alarm_async)
+{
+    uint8_t alarm_buffer[RTC_ALARM_REGISTER_SIZE] = {0x30, 0x45, 0x12, 0x15, 0x00};
+    uint8_t control_2 = RTC_CTRL2_MI | RTC_CTRL2_COF_MASK;
+
+    zassert_equal(write_register(&control_2, 1, RTC_CONTROL_2_ADDRESS), RTC_SUCCESS, "Failed to write Control_2");
+    pcf85063a_cache_invalidate(rtc_dev);
+
+    zassert_equal(pcf85063a_set_alarm_async(rtc_dev, alarm_buffer, sizeof(alarm_buffer), async_test_callback,
+                                            (void *)0),
+                  RTC_SUCCESS, "pcf85063a_set_alarm_async failed to queue");
+    zassert_equal(k_sem_take(&async_done, K_MSEC(100)), 0, "Async alarm did not complete");
+    zassert_equal(async_results[0], RTC_SUCCESS, "Async alarm failed");
+
+    pcf85063a_cache_invalidate(rtc_dev);
+    zassert_equal(read_register(&control_2, 1, RTC_CONTROL_2_ADDRESS), RTC_SUCCESS, "Failed to read Control_2");
+    zassert_equal(control_2 & ~RTC_CTRL2_TF, RTC_CTRL2_AIE | RTC_CTRL2_MI | RTC_CTRL2_COF_MASK,
+                  "Control_2 settings not kept");
+
+    control_2 = 0;
+    zassert_equal(write_register(&control_2, 1, RTC_CONTROL_2_ADDRESS), RTC_SUCCESS, "Failed to disarm the alarm");
+}
+
+#ifdef CONFIG_RTC_ALARM
+/**
+ * @brief Test the alarm of the Zephyr RTC API
+ *
+ * This test programs an alarm through rtc_alarm_set_time(), reads it back and
+ * checks that out-of-range fields are rejected instead of being programmed.
+ */
+ZTEST(pcf85063a_tests, test_rtc_api_alarm)
+{
+    const uint16_t fields = RTC_ALARM_TIME_MASK_SECOND | RTC_ALARM_TIME_MASK_MINUTE | RTC_ALARM_TIME_MASK_WEEKDAY;
+    struct rtc_time set = {.tm_sec = 15, .tm_min = 30, .tm_wday = 6};
+    struct rtc_time get;
+    uint16_t mask = 0;
+
+    zassert_equal(rtc_alarm_set_time(rtc_dev, 0, fields, &set), 0, "rtc_alarm_set_time failed");
+    zassert_equal(rtc_alarm_get_time(rtc_dev, 0, &mask, &get), 0, "rtc_alarm_get_time failed");
+    zassert_equal(mask, fields, "Alarm fields not kept");
+    zassert_equal(get.tm_sec, 15, "Alarm seconds not kept");
+    zassert_equal(get.tm_min, 30, "Alarm minutes not kept");
+    zassert_equal(get.tm_wday, 6, "Alarm weekday not kept");
+
+    set.tm_sec = 75;
+    zassert_equal(rtc_alarm_set_time(rtc_dev, 0, fields, &set), -EINVAL, "Seconds past 59 accepted");
+    set.tm_sec = 15;
+    set.tm_wday = -1;
+    zassert_equal(rtc_alarm_set_time(rtc_dev, 0, fields, &set), -EINVAL, "Negative weekday accepted");
+    zassert_equal(rtc_alarm_get_time(rtc_dev, 0, &mask, &get), 0, "rtc_alarm_get_time failed");
+    zassert_equal(get.tm_wday, 6, "Rejected alarm was programmed");
+
+    zassert_equal(rtc_alarm_set_time(rtc_dev, 0, 0, NULL), 0, "Failed to disable the alarm");
+}
+#endif /* CONFIG_RTC_ALARM */
+
+#ifdef CONFIG_PCF85063A_INTERRUPT
+
 /**
  * @brief Test the alarm functionality
  *
@@ -175,6 +759,7 @@ ZTEST(pcf85063a_tests, test_alarm)
     zassert_equal(ret, RTC_SUCCESS, "Failed to set alarm");
 
     // Wait for alarm to trigger (with timeout)
+    rtc_run_seconds(2);
     int64_t start_time = k_uptime_get();
     while (!alarm_trigger && (k_uptime_get() - start_time < 10000)) {
         k_sleep(K_MSEC(100));
@@ -184,6 +769,264 @@ ZTEST(pcf85063a_tests, test_alarm)
     zassert_true(alarm_trigger, "Alarm did not trigger within expected time");
 }
 
+#ifdef CONFIG_RTC_ALARM
+static K_SEM_DEFINE(mux_fired, 0, 4);
+static int64_t mux_fired_at[3];
+
+static void alarm_mux_test_handler(struct pcf85063a_alarm_entry *entry, int64_t now)
+{
+    mux_fired_at[(uintptr_t)entry->user_data] = now;
+    k_sem_give(&mux_fired);
+}
+
+/**
+ * @brief Test the software alarm multiplexer
+ *
+ * This test schedules three entries on the single hardware alarm. The first
+ * two have overlapping slack windows and must share one wake-up, the third
+ * is cancelled before it expires and must leave the hardware alarm disabled.
+ */
+ZTEST(pcf85063a_tests, test_alarm_mux)
+{
+    struct pcf85063a_alarm_entry entries[3];
+    const int64_t start = 1709210096LL;
+
+    zassert_equal(rtc_set_epoch(start), RTC_SUCCESS, "rtc_set_epoch failed");
+    zassert_equal(pcf85063a_alarm_mux_init(rtc_dev), RTC_SUCCESS, "pcf85063a_alarm_mux_init failed");
+
+    for (uintptr_t i = 0; i < ARRAY_SIZE(entries); i++) {
+        pcf85063a_alarm_entry_init(&entries[i], alarm_mux_test_handler, (void *)i);
+        mux_fired_at[i] = 0;
+    }
+    zassert_equal(pcf85063a_alarm_mux_add(rtc_dev, &entries[0], start + 2, 3), RTC_SUCCESS, "Failed to add entry 0");
+    zassert_equal(pcf85063a_alarm_mux_add(rtc_dev, &entries[1], start + 4, 0), RTC_SUCCESS, "Failed to add entry 1");
+    zassert_equal(pcf85063a_alarm_mux_add(rtc_dev, &entries[2], start + 100, 0), RTC_SUCCESS,
+                  "Failed to add entry 2");
+
+    // Entry 0 may wait for entry 1, so the hardware alarm is set to start + 4
+    uint16_t mask = 0;
+    struct rtc_time alarm_time;
+    zassert_equal(rtc_alarm_get_time(rtc_dev, 0, &mask, &alarm_time), 0, "Failed to read the alarm");
+    zassert_equal(alarm_time.tm_sec, 0, "Hardware alarm not on the earliest expiry");
+    zassert_equal(alarm_time.tm_min, 35, "Hardware alarm not on the earliest expiry");
+
+    rtc_run_seconds(4);
+    zassert_equal(k_sem_take(&mux_fired, K_SECONDS(10)), 0, "Entry 0 did not fire");
+    zassert_equal(k_sem_take(&mux_fired, K_SECONDS(1)), 0, "Entry 1 did not fire");
+    zassert_equal(mux_fired_at[0], mux_fired_at[1], "Entries 0 and 1 did not share a wake-up");
+    zassert_true(mux_fired_at[1] >= start + 4, "Entry 1 fired early");
+    zassert_equal(mux_fired_at[2], 0, "Entry 2 fired early");
+
+    zassert_equal(pcf85063a_alarm_mux_cancel(&entries[2]), RTC_SUCCESS, "Failed to cancel entry 2");
+    zassert_equal(pcf85063a_alarm_mux_cancel(&entries[2]), RTC_ERROR_INVALID_PARAMETER,
+                  "Cancelling an idle entry should fail");
+    zassert_equal(rtc_alarm_get_time(rtc_dev, 0, &mask, &alarm_time), 0, "Failed to read the alarm");
+    zassert_equal(mask, 0, "Hardware alarm still enabled with no entries");
+
+    zassert_equal(pcf85063a_alarm_mux_add(rtc_dev, &entries[0], 0, 0), RTC_ERROR_INVALID_PARAMETER,
+                  "Deadline before 2000 should be rejected");
+    zassert_equal(pcf85063a_alarm_mux_init(rtc_dev), RTC_ERROR_INVALID_PARAMETER,
+                  "A second mux on the same RTC should be rejected");
+    zassert_equal(pcf85063a_alarm_mux_deinit(rtc_dev), RTC_SUCCESS, "pcf85063a_alarm_mux_deinit failed");
+    zassert_false(pcf85063a_alarm_mux_active(rtc_dev), "Alarm still owned by the mux");
+}
+#endif /* CONFIG_RTC_ALARM */
+#endif /* CONFIG_PCF85063A_INTERRUPT */
+#endif /* CONFIG_PCF85063A_ALARM */
+
+#ifdef CONFIG_PCF85063A_INTERRUPT
+static K_SEM_DEFINE(timer_ticked, 0, 4);
+
+static void timer_test_handler(const struct device *dev, void *user_data)
+{
+    k_sem_give(&timer_ticked);
+}
+
+/**
+ * @brief Test the countdown timer tick
+ *
+ * This test starts a 1 s tick, expects one handler call per second through
+ * the INT line and checks that stopping the timer clears its mode register.
+ */
+ZTEST(pcf85063a_tests, test_countdown_timer)
+{
+    k_sem_reset(&timer_ticked);
+    rtc_reset_int_latency();
+#ifdef CONFIG_PCF85063A_STATS
+    struct pcf85063a_op_stats stats;
+    pcf85063a_stats_reset();
+#endif
+    rtc_error_t ret = rtc_timer_start(RTC_TIMER_CLOCK_1HZ, 1, false, timer_test_handler, NULL);
+    zassert_equal(ret, RTC_SUCCESS, "rtc_timer_start failed");
+#ifdef CONFIG_PCF85063A_STATS
+    // Stop, Control_2 and reload go out as one transfer
+    pcf85063a_stats_get(PCF85063A_STATS_WRITE, &stats);
+    zassert_equal(stats.calls, 1, "Expected one bus write per timer start, got %u", stats.calls);
+#endif
+
+    for (int i = 0; i < 3; i++) {
+        rtc_run_seconds(1);
+        zassert_equal(k_sem_take(&timer_ticked, K_SECONDS(2)), 0, "Timer tick %d not delivered", i);
+    }
+
+    ret = rtc_timer_stop();
+    zassert_equal(ret, RTC_SUCCESS, "rtc_timer_stop failed");
+
+    // Every tick went through the interrupt path and landed in the latency histogram
+    struct pcf85063a_int_latency latency;
+    zassert_equal(rtc_get_int_latency(&latency), RTC_SUCCESS, "rtc_get_int_latency failed");
+    zassert_true(latency.count >= 3, "Expected 3 interrupt latencies, got %u", latency.count);
+    uint32_t bucketed = 0;
+    for (int i = 0; i < RTC_INT_LATENCY_BUCKETS; i++) {
+        bucketed += latency.buckets[i];
+    }
+    zassert_equal(bucketed, latency.count, "Histogram buckets do not add up to the count");
+    zassert_true(latency.max_cycles > 0, "Latency max not recorded");
+
+    uint8_t timer_mode = 0xFF;
+    ret = read_register(&timer_mode, sizeof(timer_mode), RTC_TIMER_MODE_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "Failed to read Timer_mode");
+    zassert_equal(timer_mode & (RTC_TIMER_MODE_TE | RTC_TIMER_MODE_TIE), 0, "Timer still enabled");
+
+    rtc_run_seconds(2);
+    zassert_not_equal(k_sem_take(&timer_ticked, K_MSEC(500)), 0, "Timer ticked after stop");
+
+    zassert_equal(rtc_timer_start(RTC_TIMER_CLOCK_1HZ, 0, false, NULL, NULL), RTC_ERROR_INVALID_PARAMETER,
+                  "rtc_timer_start should reject a zero reload");
+}
+#endif
+
+#ifdef CONFIG_PCF85063A_STATS
+/**
+ * @brief Test the driver statistics
+ *
+ * This test resets the statistics, runs one bus write and one bus read and
+ * checks the calls, bytes and latencies recorded for them.
+ */
+ZTEST(pcf85063a_tests, test_stats)
+{
+    uint8_t write_buffer[2] = {0x12, 0x34};
+    uint8_t read_buffer[RTC_TIME_REGISTER_SIZE];
+    struct pcf85063a_op_stats stats;
+
+    pcf85063a_stats_reset();
+    zassert_equal(write_register(write_buffer, sizeof(write_buffer), RTC_OFFSET_ADDRESS), RTC_SUCCESS,
+                  "Failed to write registers");
+    zassert_equal(read_register(read_buffer, sizeof(read_buffer), RTC_TIME_REGISTER_ADDRESS), RTC_SUCCESS,
+                  "Failed to read registers");
+
+    pcf85063a_stats_get(PCF85063A_STATS_WRITE, &stats);
+    zassert_equal(stats.calls, 1, "Expected one write, got %u", stats.calls);
+    zassert_equal(stats.bytes, sizeof(write_buffer), "Write bytes not counted");
+    zassert_equal(stats.errors, 0, "Unexpected write errors");
+
+    pcf85063a_stats_get(PCF85063A_STATS_READ, &stats);
+    zassert_equal(stats.calls, 1, "Expected one read, got %u", stats.calls);
+    zassert_equal(stats.bytes, sizeof(read_buffer), "Read bytes not counted");
+    zassert_true(stats.min_cycles <= stats.max_cycles, "Latency min above max");
+    zassert_equal(pcf85063a_stats_percentile(&stats, 99), stats.max_cycles,
+                  "p99 of a single sample should be the sample");
+
+    pcf85063a_stats_reset();
+    pcf85063a_stats_get(PCF85063A_STATS_READ, &stats);
+    zassert_equal(stats.calls, 0, "Stats not cleared by reset");
+}
+#endif
+
+#ifdef CONFIG_PCF85063A_JOURNAL
+// Keeps every batch the journal writes
+struct ram_sink {
+    struct pcf85063a_journal_sink sink;
+    uint8_t data[2 * RTC_JOURNAL_BATCH_SIZE];
+    size_t size;
+    uint32_t batches;
+};
+
+static int ram_sink_write(struct pcf85063a_journal_sink *sink, const uint8_t *batch, size_t size)
+{
+    struct ram_sink *ram = CONTAINER_OF(sink, struct ram_sink, sink);
+
+    if (ram->size + size > sizeof(ram->data)) {
+        return -ENOSPC;
+    }
+    memcpy(&ram->data[ram->size], batch, size);
+    ram->size += size;
+    ram->batches++;
+    return 0;
+}
+
+static struct {
+    uint16_t ids[4];
+    int64_t times[4];
+    uint8_t payload_sizes[4];
+    uint8_t last_payload;
+    size_t count;
+} decoded;
+
+static void journal_test_handler(uint16_t event_id, int64_t epoch_ms, const uint8_t *payload,
+                                 uint8_t size, void *user_data)
+{
+    ARG_UNUSED(user_data);
+
+    if (decoded.count < ARRAY_SIZE(decoded.ids)) {
+        decoded.ids[decoded.count] = event_id;
+        decoded.times[decoded.count] = epoch_ms;
+        decoded.payload_sizes[decoded.count] = size;
+        decoded.last_payload = size > 0 ? payload[size - 1] : 0;
+    }
+    decoded.count++;
+}
+
+/**
+ * @brief Test the event journal
+ *
+ * This test logs events with and without payload, flushes them into a RAM sink
+ * and checks that they decode to the right ids, payloads and wall times in a
+ * few bytes each.
+ */
+ZTEST(pcf85063a_tests, test_journal)
+{
+    static struct ram_sink ram = {.sink = {.write = ram_sink_write}};
+    const uint8_t reading[2] = {0x12, 0x34};
+
+    // 12:00:00 Jul 15 2023 is 1689422400 seconds after the Unix epoch
+    uint8_t current_time[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x12, 0x15, 0x00, 0x07, 0x23};
+    zassert_equal(write_register(current_time, sizeof(current_time), RTC_TIME_REGISTER_ADDRESS), RTC_SUCCESS,
+                  "Failed to set current time");
+
+    zassert_equal(pcf85063a_journal_log(1, NULL, 0), RTC_ERROR_DEVICE_SETUP, "Logging should fail before init");
+    zassert_equal(pcf85063a_journal_init(rtc_dev, &ram.sink), RTC_SUCCESS, "Journal init failed");
+
+    zassert_equal(pcf85063a_journal_log(1, NULL, 0), RTC_SUCCESS, "Logging an event failed");
+    k_msleep(20);
+    zassert_equal(pcf85063a_journal_log(300, reading, sizeof(reading)), RTC_SUCCESS, "Logging an event failed");
+    zassert_equal(pcf85063a_journal_log(2, reading, RTC_JOURNAL_PAYLOAD_MAX + 1), RTC_ERROR_INVALID_PARAMETER,
+                  "Oversized payload should be rejected");
+    zassert_equal(pcf85063a_journal_flush(), RTC_SUCCESS, "Journal flush failed");
+    zassert_equal(ram.batches, 1, "Both events should share one batch");
+
+    // Anchor of up to 7 bytes, then 3 bytes for the first event and 6 for the second
+    zassert_true(ram.size <= 7 + 3 + 6, "Batch of %u bytes is not compact", (unsigned int)ram.size);
+
+    memset(&decoded, 0, sizeof(decoded));
+    zassert_equal(pcf85063a_journal_decode(ram.data, ram.size, journal_test_handler, NULL), RTC_SUCCESS,
+                  "Decoding the batch failed");
+    zassert_equal(decoded.count, 2, "Expected two events");
+    zassert_equal(decoded.ids[0], 1, "Wrong first event id");
+    zassert_equal(decoded.ids[1], 300, "Wrong second event id");
+    zassert_equal(decoded.payload_sizes[0], 0, "First event has no payload");
+    zassert_equal(decoded.payload_sizes[1], sizeof(reading), "Wrong payload size");
+    zassert_equal(decoded.last_payload, 0x34, "Wrong payload");
+    zassert_true(decoded.times[0] >= 1689422400000LL && decoded.times[0] < 1689422402000LL,
+                 "Event time %lld is not anchored to the RTC", decoded.times[0]);
+    zassert_true(decoded.times[1] - decoded.times[0] >= 20, "Events are not 20 ms apart");
+
+    zassert_equal(pcf85063a_journal_decode(ram.data + 1, ram.size - 1, journal_test_handler, NULL),
+                  RTC_ERROR_INVALID_PARAMETER, "A batch without anchor should be rejected");
+    zassert_equal(pcf85063a_journal_dropped(), 0, "No event should have been dropped");
+}
+#endif
+
 /**
  * @brief Test error handling in RTC functions
  *
@@ -195,5 +1038,448 @@ ZTEST(pcf85063a_tests, test_error_handling)
     zassert_equal(initialize_RTC(NULL), RTC_ERROR_INVALID_PARAMETER, "initialize_RTC should fail with NULL input");
     zassert_equal(read_register(NULL, 1, 0), RTC_ERROR_INVALID_PARAMETER, "read_register should fail with NULL buffer");
     zassert_equal(write_register(NULL, 1, 0), RTC_ERROR_INVALID_PARAMETER, "write_register should fail with NULL buffer");
+#ifdef CONFIG_PCF85063A_ALARM
     zassert_equal(set_alarm(NULL, RTC_ALARM_REGISTER_SIZE), RTC_ERROR_INVALID_PARAMETER, "set_alarm should fail with NULL buffer");
-}
\ No newline at end of file
+#endif
+}
+
+#ifdef CONFIG_EMUL
+/**
+ * @brief Test the emulator's calendar and countdown timer model
+ *
+ * This test checks the leap day rollover and that an expiring countdown
+ * timer sets TF and reloads, all in virtual time.
+ */
+ZTEST(pcf85063a_tests, test_emul_calendar_and_timer)
+{
+    // 23:59:59 Wednesday Feb 28 2024 rolls over to Thursday Feb 29
+    uint8_t current_time[RTC_TIME_REGISTER_SIZE] = {0x59, 0x59, 0x23, 0x28, 0x03, 0x02, 0x24};
+    rtc_error_t ret = write_register(current_time, sizeof(current_time), RTC_TIME_REGISTER_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "Failed to set current time");
+
+    // 1 Hz countdown from 2 without interrupt
+    uint8_t timer[2] = {0x02, 0x14};
+    ret = write_register(timer, sizeof(timer), RTC_TIMER_VALUE_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "Failed to start timer");
+
+    rtc_run_seconds(2);
+
+    uint8_t registers[RTC_REGISTER_SIZE];
+    pcf85063a_emul_get_registers(rtc_emul, registers);
+    zassert_equal(registers[RTC_TIME_REGISTER_ADDRESS + DATE_INDEX], 0x29, "Leap day not reached");
+    zassert_equal(registers[RTC_TIME_REGISTER_ADDRESS + WEEKDAY_INDEX], 0x04, "Weekday not advanced");
+    zassert_equal(registers[RTC_TIME_REGISTER_ADDRESS + MONTH_INDEX], 0x02, "Month advanced early");
+    zassert_true(registers[RTC_CONTROL_2_ADDRESS] & RTC_CTRL2_TF, "Timer flag not set");
+    zassert_equal(registers[RTC_TIMER_VALUE_ADDRESS], 0x02, "Timer not reloaded");
+
+    // Stop the timer and clear TF again
+    timer[1] = 0x00;
+    ret = write_register(&timer[1], 1, RTC_TIMER_MODE_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "Failed to stop timer");
+    uint8_t control_2 = 0x00;
+    ret = write_register(&control_2, 1, RTC_CONTROL_2_ADDRESS);
+    zassert_equal(ret, RTC_SUCCESS, "Failed to clear timer flag");
+}
+
+/**
+ * @brief Test the warm-boot path of initialize_RTC_warm
+ *
+ * This test checks that a chip holding the signature and a running clock
+ * keeps its time, and that a stopped oscillator gets the time and the
+ * signature written again.
+ */
+ZTEST(pcf85063a_tests, test_warm_boot)
+{
+    const uint8_t *time_array = seed_time();
+    // 12:00:00 Saturday Jul 15 2023
+    const uint8_t kept_time[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x12, 0x15, 0x06, 0x07, 0x23};
+    uint8_t registers[RTC_REGISTER_SIZE];
+    bool warm_boot;
+
+    pcf85063a_emul_get_registers(rtc_emul, registers);
+    registers[RTC_RAM_BYTE_ADDRESS] = RTC_WARM_BOOT_SIGNATURE;
+    memcpy(&registers[RTC_TIME_REGISTER_ADDRESS], kept_time, sizeof(kept_time));
+    pcf85063a_emul_set_registers(rtc_emul, registers);
+    rtc_cache_invalidate();
+
+    zassert_equal(initialize_RTC_warm(time_array, &warm_boot), RTC_SUCCESS, "initialize_RTC_warm failed");
+    zassert_true(warm_boot, "Running clock not detected");
+    pcf85063a_emul_get_registers(rtc_emul, registers);
+    zassert_mem_equal(&registers[RTC_TIME_REGISTER_ADDRESS], kept_time, sizeof(kept_time),
+                      "Kept time was overwritten");
+
+    // Oscillator stopped since the signature was written
+    registers[RTC_TIME_REGISTER_ADDRESS + SECONDS_INDEX] |= RTC_OSCILLATOR_STOPPED;
+    pcf85063a_emul_set_registers(rtc_emul, registers);
+    rtc_cache_invalidate();
+
+    zassert_equal(initialize_RTC_warm(time_array, &warm_boot), RTC_SUCCESS, "initialize_RTC_warm failed");
+    zassert_false(warm_boot, "Stopped oscillator not detected");
+    pcf85063a_emul_get_registers(rtc_emul, registers);
+    zassert_equal(registers[RTC_RAM_BYTE_ADDRESS], RTC_WARM_BOOT_SIGNATURE, "Signature not written");
+    zassert_mem_equal(&registers[RTC_TIME_REGISTER_ADDRESS], time_array, RTC_TIME_REGISTER_SIZE,
+                      "Time not written after oscillator stop");
+
+    zassert_equal(initialize_RTC_warm(NULL, &warm_boot), RTC_ERROR_INVALID_PARAMETER,
+                  "initialize_RTC_warm should fail with NULL input");
+}
+
+#ifdef CONFIG_PCF85063A_DEEP_SLEEP
+K_THREAD_STACK_DEFINE(sleeper_stack, 1024);
+static struct k_thread sleeper_thread;
+static rtc_error_t sleeper_result;
+
+static void deep_sleeper(void *wake_epoch, void *unused1, void *unused2)
+{
+    sleeper_result = rtc_deep_sleep_until(*(int64_t *)wake_epoch);
+}
+
+/**
+ * @brief Test the RTC-backed deep sleep
+ *
+ * This test sleeps a thread for an hour of virtual time, checks that it wakes
+ * on the RTC alarm, that the uptime is corrected by the time the kernel did
+ * not see and that the alarm it borrowed is put back.
+ */
+ZTEST(pcf85063a_tests, test_deep_sleep)
+{
+    uint8_t current_time[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x12, 0x15, 0x00, 0x07, 0x23};
+    zassert_equal(write_register(current_time, sizeof(current_time), RTC_TIME_REGISTER_ADDRESS), RTC_SUCCESS,
+                  "Failed to set current time");
+    uint8_t alarm_time[RTC_ALARM_REGISTER_SIZE] = {0x00, 0x30, 0x08, 0x01, 0x00};
+    zassert_equal(set_alarm(alarm_time, RTC_ALARM_REGISTER_SIZE), RTC_SUCCESS, "Failed to set alarm");
+    alarm_trigger = false;
+
+    static int64_t wake_epoch = 1689422400LL + 3600;
+    const int64_t correction = rtc_uptime_ms() - k_uptime_get();
+    k_thread_create(&sleeper_thread, sleeper_stack, K_THREAD_STACK_SIZEOF(sleeper_stack), deep_sleeper,
+                    &wake_epoch, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+    // Let it arm the alarm, then run the hour the kernel sleeps through
+    k_msleep(100);
+    zassert_not_equal(k_thread_join(&sleeper_thread, K_NO_WAIT), 0, "Deep sleep returned early");
+    rtc_run_seconds(3600);
+
+    zassert_equal(k_thread_join(&sleeper_thread, K_SECONDS(1)), 0, "Deep sleep did not wake on the alarm");
+    zassert_equal(sleeper_result, RTC_SUCCESS, "Deep sleep failed");
+    zassert_false(alarm_trigger, "The wake-up was reported as an RTC API alarm");
+    zassert_within(rtc_uptime_ms() - k_uptime_get() - correction, 3600 * 1000, 1000,
+                   "Uptime was not corrected for the deep sleep");
+
+    uint8_t registers[RTC_REGISTER_SIZE];
+    pcf85063a_emul_get_registers(rtc_emul, registers);
+    zassert_mem_equal(&registers[RTC_ALARM_REGISTER_ADDRESS], alarm_time, RTC_ALARM_REGISTER_SIZE,
+                      "Borrowed alarm was not restored");
+    zassert_true(registers[RTC_CONTROL_2_ADDRESS] & RTC_CTRL2_AIE, "Alarm interrupt was not restored");
+
+    zassert_equal(rtc_deep_sleep_until(wake_epoch - 60), RTC_SUCCESS, "A past wake-up should return at once");
+}
+
+#ifdef CONFIG_RTC_ALARM
+/**
+ * @brief Test a deep sleep on an RTC whose alarm belongs to the multiplexer
+ *
+ * This test sleeps a thread for an hour while a multiplexer entry is due half
+ * way through. The entry must fire without waking the sleeper, and the sleep
+ * must end on its own entry and leave no alarm behind.
+ */
+ZTEST(pcf85063a_tests, test_deep_sleep_mux)
+{
+    struct pcf85063a_alarm_entry entry;
+    const int64_t start = 1689422400LL;
+    static int64_t wake_epoch = 1689422400LL + 3600;
+
+    zassert_equal(rtc_set_epoch(start), RTC_SUCCESS, "rtc_set_epoch failed");
+    zassert_equal(pcf85063a_alarm_mux_init(rtc_dev), RTC_SUCCESS, "pcf85063a_alarm_mux_init failed");
+    pcf85063a_alarm_entry_init(&entry, alarm_mux_test_handler, (void *)0);
+    mux_fired_at[0] = 0;
+    k_sem_reset(&mux_fired);
+    zassert_equal(pcf85063a_alarm_mux_add(rtc_dev, &entry, start + 1800, 0), RTC_SUCCESS, "Failed to add entry");
+
+    const int64_t correction = rtc_uptime_ms() - k_uptime_get();
+    k_thread_create(&sleeper_thread, sleeper_stack, K_THREAD_STACK_SIZEOF(sleeper_stack), deep_sleeper,
+                    &wake_epoch, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+    k_msleep(100);
+
+    rtc_run_seconds(1800);
+    zassert_equal(k_sem_take(&mux_fired, K_SECONDS(1)), 0, "Entry due during the sleep did not fire");
+    zassert_equal(mux_fired_at[0], start + 1800, "Entry fired at %lld", mux_fired_at[0]);
+    zassert_not_equal(k_thread_join(&sleeper_thread, K_MSEC(100)), 0, "Deep sleep woke on another entry");
+
+    rtc_run_seconds(1800);
+    zassert_equal(k_thread_join(&sleeper_thread, K_SECONDS(1)), 0, "Deep sleep did not wake on its entry");
+    zassert_equal(sleeper_result, RTC_SUCCESS, "Deep sleep failed");
+    zassert_within(rtc_uptime_ms() - k_uptime_get() - correction, 3600 * 1000, 1500,
+                   "Uptime was not corrected for the deep sleep");
+
+    uint16_t mask = 0;
+    struct rtc_time alarm_time;
+    zassert_equal(rtc_alarm_get_time(rtc_dev, 0, &mask, &alarm_time), 0, "Failed to read the alarm");
+    zassert_equal(mask, 0, "Hardware alarm still enabled after the sleep");
+    zassert_equal(pcf85063a_alarm_mux_deinit(rtc_dev), RTC_SUCCESS, "pcf85063a_alarm_mux_deinit failed");
+}
+#endif
+#endif
+
+#if defined(CONFIG_PCF85063A_ALARM) && defined(CONFIG_PCF85063A_INTERRUPT)
+
+/**
+ * @brief Test alarms the chip repeats through its AEN bits
+ *
+ * This test programs an every-minute alarm and a weekly alarm, checks the
+ * alarm registers and that the minute alarm fires twice without being
+ * written again.
+ */
+ZTEST(pcf85063a_tests, test_recurring_alarm)
+{
+    // 12:00:50 Saturday Jul 15 2023
+    uint8_t current_time[RTC_TIME_REGISTER_SIZE] = {0x50, 0x00, 0x12, 0x15, 0x06, 0x07, 0x23};
+    zassert_equal(write_register(current_time, sizeof(current_time), RTC_TIME_REGISTER_ADDRESS), RTC_SUCCESS,
+                  "Failed to set current time");
+
+    zassert_equal(rtc_set_recurring_alarm(RTC_ALARM_WEEKLY, 6, 7, 30, 0), RTC_SUCCESS,
+                  "Failed to set weekly alarm");
+    const uint8_t weekly[RTC_ALARM_REGISTER_SIZE] = {0x00, 0x30, 0x07, 0x80, 0x06};
+    uint8_t registers[RTC_REGISTER_SIZE];
+    pcf85063a_emul_get_registers(rtc_emul, registers);
+    zassert_mem_equal(&registers[RTC_ALARM_REGISTER_ADDRESS], weekly, RTC_ALARM_REGISTER_SIZE,
+                      "Weekly alarm not mapped onto the AEN bits");
+
+#ifdef CONFIG_PCF85063A_VALIDATION
+    zassert_equal(rtc_set_recurring_alarm(RTC_ALARM_WEEKLY, 7, 7, 30, 0), RTC_ERROR_INVALID_PARAMETER,
+                  "Weekday 7 should be rejected");
+    zassert_equal(rtc_set_recurring_alarm(RTC_ALARM_MONTHLY, 0, 7, 30, 0), RTC_ERROR_INVALID_PARAMETER,
+                  "Date 0 should be rejected");
+#endif
+
+    zassert_equal(rtc_set_recurring_alarm(RTC_ALARM_EVERY_MINUTE, 0, 0, 0, 5), RTC_SUCCESS,
+                  "Failed to set minute alarm");
+    const uint8_t every_minute[RTC_ALARM_REGISTER_SIZE] = {0x05, 0x80, 0x80, 0x80, 0x80};
+    pcf85063a_emul_get_registers(rtc_emul, registers);
+    zassert_mem_equal(&registers[RTC_ALARM_REGISTER_ADDRESS], every_minute, RTC_ALARM_REGISTER_SIZE,
+                      "Minute alarm not mapped onto the AEN bits");
+
+    for (int i = 0; i < 2; i++) {
+        alarm_trigger = false;
+        // 12:01:05, then 12:02:05
+        rtc_run_seconds(i == 0 ? 15 : 60);
+        int64_t start_time = k_uptime_get();
+        while (!alarm_trigger && (k_uptime_get() - start_time < 1000)) {
+            k_sleep(K_MSEC(10));
+        }
+        zassert_true(alarm_trigger, "Minute alarm did not fire for the %d. time", i + 1);
+    }
+
+    uint8_t control_2 = 0x00;
+    zassert_equal(write_register(&control_2, 1, RTC_CONTROL_2_ADDRESS), RTC_SUCCESS, "Failed to disarm the alarm");
+}
+#endif
+
+/**
+ * @brief Test the retry, deadline and circuit breaker policy of bus transfers
+ *
+ * This test fails fewer transfers than the retry budget and expects the read
+ * to go through, synchronous and async, then fails the bus until the breaker
+ * opens and checks that reads of both kinds fail fast on a healthy bus until
+ * the probe after the open time.
+ */
+ZTEST(pcf85063a_tests, test_bus_recovery)
+{
+    struct rtc_bus_policy policy = {
+        .deadline_ms = 50, .retries = 2, .backoff_ms = 1, .trip_failures = 2, .open_ms = 100,
+    };
+    const struct rtc_bus_policy defaults = {
+        .deadline_ms = CONFIG_PCF85063A_BUS_DEADLINE_MS,
+        .retries = CONFIG_PCF85063A_BUS_RETRIES,
+        .backoff_ms = CONFIG_PCF85063A_BUS_BACKOFF_MS,
+        .trip_failures = CONFIG_PCF85063A_BUS_TRIP_FAILURES,
+        .open_ms = CONFIG_PCF85063A_BUS_OPEN_MS,
+    };
+    uint8_t time_block[RTC_TIME_REGISTER_SIZE];
+    struct rtc_breaker breaker;
+
+    zassert_equal(rtc_set_bus_policy(&policy), RTC_SUCCESS, "rtc_set_bus_policy failed");
+
+    pcf85063a_emul_fail_transfers(rtc_emul, 2, -EIO);
+    zassert_equal(read_register(time_block, sizeof(time_block), RTC_TIME_REGISTER_ADDRESS), RTC_SUCCESS,
+                  "Read not retried");
+    pcf85063a_emul_fail_transfers(rtc_emul, 2, -EIO);
+    zassert_equal(read_register_async(time_block, sizeof(time_block), RTC_TIME_REGISTER_ADDRESS,
+                                      async_test_callback, (void *)0),
+                  RTC_SUCCESS, "read_register_async failed to queue");
+    zassert_equal(k_sem_take(&async_done, K_MSEC(100)), 0, "Async read did not complete");
+    zassert_equal(async_results[0], RTC_SUCCESS, "Async read not retried");
+
+    // Two reads failing every attempt open the breaker
+    pcf85063a_emul_fail_transfers(rtc_emul, UINT32_MAX, -EIO);
+    for (int i = 0; i < 2; i++) {
+        zassert_equal(read_register(time_block, sizeof(time_block), RTC_TIME_REGISTER_ADDRESS),
+                      RTC_ERROR_I2C_READ, "Failed read %d not reported", i);
+    }
+    zassert_equal(rtc_get_bus_health(&breaker), RTC_SUCCESS, "rtc_get_bus_health failed");
+    zassert_equal(breaker.state, RTC_BREAKER_OPEN, "Breaker not opened");
+
+    // While open, reads fail without reaching the bus, which works again
+    pcf85063a_emul_fail_transfers(rtc_emul, 0, 0);
+    zassert_equal(read_register(time_block, sizeof(time_block), RTC_TIME_REGISTER_ADDRESS),
+                  RTC_ERROR_BUS_UNAVAILABLE, "Open breaker let a read through");
+    zassert_equal(read_register_async(time_block, sizeof(time_block), RTC_TIME_REGISTER_ADDRESS,
+                                      async_test_callback, (void *)0),
+                  RTC_SUCCESS, "read_register_async failed to queue");
+    zassert_equal(k_sem_take(&async_done, K_MSEC(100)), 0, "Async read did not complete");
+    zassert_equal(async_results[0], RTC_ERROR_BUS_UNAVAILABLE, "Open breaker let an async read through");
+    k_msleep(policy.open_ms);
+    zassert_equal(read_register(time_block, sizeof(time_block), RTC_TIME_REGISTER_ADDRESS), RTC_SUCCESS,
+                  "Probe after the open time failed");
+    zassert_equal(rtc_get_bus_health(&breaker), RTC_SUCCESS, "rtc_get_bus_health failed");
+    zassert_equal(breaker.state, RTC_BREAKER_CLOSED, "Breaker not closed by the probe");
+
+    // A 40 ms backoff leaves no room in the deadline for the second retry
+    policy.backoff_ms = 40;
+    zassert_equal(rtc_set_bus_policy(&policy), RTC_SUCCESS, "rtc_set_bus_policy failed");
+    pcf85063a_emul_fail_transfers(rtc_emul, 3, -EIO);
+    zassert_equal(read_register(time_block, sizeof(time_block), RTC_TIME_REGISTER_ADDRESS), RTC_ERROR_TIMEOUT,
+                  "Retries not cut at the deadline");
+
+    pcf85063a_emul_fail_transfers(rtc_emul, 0, 0);
+    policy.trip_failures = 0;
+    zassert_equal(rtc_set_bus_policy(&policy), RTC_ERROR_INVALID_PARAMETER, "A breaker that never closes was accepted");
+    zassert_equal(rtc_set_bus_policy(&defaults), RTC_SUCCESS, "rtc_set_bus_policy failed");
+}
+
+#if defined(CONFIG_PCF85063A_ALARM) && defined(CONFIG_PCF85063A_INTERRUPT)
+/**
+ * @brief Test that an interrupt is served once the bus comes back
+ *
+ * This test lets the alarm fire while every transfer fails, so AF can be
+ * neither read nor cleared, and checks that the alarm is reported after the
+ * bus recovers although INT gives no second edge.
+ */
+ZTEST(pcf85063a_tests, test_int_retry)
+{
+    const struct rtc_bus_policy policy = {
+        .deadline_ms = 50, .retries = 0, .backoff_ms = 1, .trip_failures = 1, .open_ms = 100,
+    };
+    const struct rtc_bus_policy defaults = {
+        .deadline_ms = CONFIG_PCF85063A_BUS_DEADLINE_MS,
+        .retries = CONFIG_PCF85063A_BUS_RETRIES,
+        .backoff_ms = CONFIG_PCF85063A_BUS_BACKOFF_MS,
+        .trip_failures = CONFIG_PCF85063A_BUS_TRIP_FAILURES,
+        .open_ms = CONFIG_PCF85063A_BUS_OPEN_MS,
+    };
+    uint8_t current_time[RTC_TIME_REGISTER_SIZE] = {0x00, 0x00, 0x12, 0x15, 0x00, 0x07, 0x23};
+    uint8_t alarm_time[RTC_ALARM_REGISTER_SIZE] = {0x01, 0x00, 0x12, 0x15, 0x00};
+
+    zassert_equal(initialize_RTC(current_time), RTC_SUCCESS, "Failed to set current time");
+    zassert_equal(set_alarm(alarm_time, RTC_ALARM_REGISTER_SIZE), RTC_SUCCESS, "Failed to set alarm");
+    zassert_equal(rtc_set_bus_policy(&policy), RTC_SUCCESS, "rtc_set_bus_policy failed");
+    alarm_trigger = false;
+
+    pcf85063a_emul_fail_transfers(rtc_emul, UINT32_MAX, -EIO);
+    rtc_run_seconds(1);
+    k_msleep(50);
+    zassert_false(alarm_trigger, "Alarm reported without clearing AF");
+
+    pcf85063a_emul_fail_transfers(rtc_emul, 0, 0);
+    int64_t start_time = k_uptime_get();
+    while (!alarm_trigger && (k_uptime_get() - start_time < 1000)) {
+        k_sleep(K_MSEC(10));
+    }
+    zassert_true(alarm_trigger, "Alarm lost after the bus recovered");
+
+    uint8_t control_2;
+    zassert_equal(read_register(&control_2, 1, RTC_CONTROL_2_ADDRESS), RTC_SUCCESS, "Failed to read Control_2");
+    zassert_equal(control_2 & RTC_CTRL2_AF, 0, "AF not cleared");
+    zassert_equal(rtc_set_bus_policy(&defaults), RTC_SUCCESS, "rtc_set_bus_policy failed");
+}
+#endif
+
+#ifdef CONFIG_PCF85063A_CALIB
+/**
+ * @brief Passes a reference time in and lets the RTC tick over the next second edge
+ */
+static void calib_reference_at_edge(int64_t reference_us)
+{
+    zassert_equal(pcf85063a_calib_reference(reference_us), RTC_SUCCESS, "pcf85063a_calib_reference failed");
+    k_msleep(5);
+    rtc_run_seconds(1);
+    k_msleep(20);
+}
+
+/**
+ * @brief Test the drift calibration engine against an external reference
+ *
+ * This test lets the emulated RTC gain 720 ms over two hours of reference
+ * time, 100 ppm, and checks that the engine programs the matching Offset.
+ */
+ZTEST(pcf85063a_tests, test_calibration)
+{
+    const int64_t reference_us = 1689422400LL * USEC_PER_SEC;
+    struct pcf85063a_calib_status status;
+
+    zassert_equal(rtc_set_epoch(1689422400LL), RTC_SUCCESS, "rtc_set_epoch failed");
+    zassert_equal(rtc_set_offset(0), RTC_SUCCESS, "rtc_set_offset failed");
+    zassert_equal(pcf85063a_calib_reference(reference_us), RTC_ERROR_DEVICE_SETUP,
+                  "References should be refused before the engine starts");
+    zassert_equal(pcf85063a_calib_start(rtc_dev, RTC_CALIB_REF_EXTERNAL), RTC_SUCCESS,
+                  "pcf85063a_calib_start failed");
+
+    calib_reference_at_edge(reference_us);
+    // The reference counts 720 ms less over the same two hours of RTC time
+    rtc_run_seconds(7199);
+    calib_reference_at_edge(reference_us + 7200LL * USEC_PER_SEC - 720000);
+
+    zassert_equal(pcf85063a_calib_status(&status), RTC_SUCCESS, "pcf85063a_calib_status failed");
+    zassert_equal(status.updates, 1, "Offset register not updated after two hours");
+    zassert_equal(status.correction_ppb, -23 * 4340, "Correction %d ppb does not cancel 100 ppm",
+                  status.correction_ppb);
+
+    uint8_t registers[RTC_REGISTER_SIZE];
+    pcf85063a_emul_get_registers(rtc_emul, registers);
+    zassert_equal(registers[RTC_OFFSET_ADDRESS], 0x17, "Offset register holds 0x%02x", registers[RTC_OFFSET_ADDRESS]);
+
+    pcf85063a_calib_stop();
+    zassert_equal(rtc_set_offset(0), RTC_SUCCESS, "rtc_set_offset failed to clear the offset");
+}
+#endif
+
+#ifdef CONFIG_PM_DEVICE_RUNTIME
+/**
+ * @brief Test runtime power management
+ *
+ * This test lets the RTC go idle with CLKOUT running and no interrupt
+ * enabled, checks that it suspends with CLKOUT off, then checks that the next
+ * access resumes it with the CLKOUT setting restored.
+ */
+ZTEST(pcf85063a_tests, test_runtime_pm)
+{
+    enum pm_device_state state;
+    uint8_t registers[RTC_REGISTER_SIZE];
+    uint8_t timer_mode = RTC_TIMER_MODE_TCF_MASK;
+    uint8_t control_2 = 0x01; // CLKOUT at 16384 Hz, no interrupts
+
+    zassert_equal(write_register(&timer_mode, sizeof(timer_mode), RTC_TIMER_MODE_ADDRESS), RTC_SUCCESS,
+                  "Failed to stop the timer");
+    zassert_equal(write_register(&control_2, sizeof(control_2), RTC_CONTROL_2_ADDRESS), RTC_SUCCESS,
+                  "Failed to write Control_2");
+
+    k_msleep(CONFIG_PCF85063A_PM_IDLE_MS * 2);
+    zassert_equal(pm_device_state_get(rtc_dev, &state), 0, "Failed to get the PM state");
+    zassert_equal(state, PM_DEVICE_STATE_SUSPENDED, "RTC not suspended after the idle time");
+    pcf85063a_emul_get_registers(rtc_emul, registers);
+    zassert_equal(registers[RTC_CONTROL_2_ADDRESS] & RTC_CTRL2_COF_MASK, RTC_CTRL2_COF_MASK,
+                  "CLKOUT still running while suspended");
+
+    zassert_equal(pm_device_runtime_get(rtc_dev), 0, "Failed to resume the RTC");
+    zassert_equal(pm_device_state_get(rtc_dev, &state), 0, "Failed to get the PM state");
+    zassert_equal(state, PM_DEVICE_STATE_ACTIVE, "RTC not resumed");
+    pcf85063a_emul_get_registers(rtc_emul, registers);
+    zassert_equal(registers[RTC_CONTROL_2_ADDRESS] & RTC_CTRL2_COF_MASK, 0x01, "CLKOUT not restored on resume");
+    zassert_equal(pm_device_runtime_put(rtc_dev), 0, "Failed to release the RTC");
+
+    control_2 = 0x00;
+    zassert_equal(write_register(&control_2, sizeof(control_2), RTC_CONTROL_2_ADDRESS), RTC_SUCCESS,
+                  "Failed to restore Control_2");
+}
+#endif
+#endif